@@ -52,16 +52,26 @@
 
 
 /* Private variables ---------------------------------------------------------*/
-static FILE *                   _log_file;
+static struct log_file          _log_file;
 static bool                     _is_display_object = true;
 static bool                     _is_display_path   = true;
-static char                     _line_text[1024];
+static bool                     _is_all_project    = false;
+static bool                     _is_all_target     = false;
+static size_t                   _worker_qty        = 0;     /* 为 0 时跟随 CPU 核心数 */
+static char                     _history_object[MAX_PRJ_NAME_SIZE];
+static char                     _history_region[MAX_PRJ_NAME_SIZE];
+static double                   _history_percent   = 0;
+static size_t                   _history_build_qty = HISTORY_DEFAULT_BUILD_QTY;
+#if defined(ENABLE_BENCHMARK) && (ENABLE_BENCHMARK != 0)
+static bool                     _is_benchmark      = false;
+#endif
 static char *                   _current_dir;
+static struct keyword_matcher   _keyword_matcher;       /* 启动时建立，之后只读，各线程共用 */
+static struct scan_kernel       _scan;                  /* 启动时按 CPU 支持的指令集选择 */
+static struct intern_table      _intern_table;          /* object 名称及文件路径，各线程共用 */
 static ENCODING_TYPE            _encoding_type  = ENCODING_TYPE_GBK;
 static PROGRESS_STYLE           _progress_style = PROGRESS_STYLE_0;
 static struct prj_path_list *   _keil_prj_path_list;
-static struct memory_info *     _memory_info_head;
-static struct file_path_list *  _file_path_list_head;
 static const char *             _keil_prj_extension[] = 
 {
     ".uvprojx",
@@ -97,6 +107,36 @@ static struct command_list      _command_list[] =
         .cmd  = "-STYLE2",
         .desc = "Progress bar style: |XXXOOO____|",
     },
+    {
+        .cmd  = "-ALLPRJ",
+        .desc = "Analyze all keil projects found in the folder in parallel",
+    },
+    {
+        .cmd  = "-ALLTARGET",
+        .desc = "Analyze all targets of the keil project(s) in parallel",
+    },
+    {
+        .cmd  = "-JOBS=N",
+        .desc = "Number of worker threads used by -ALLPRJ / -ALLTARGET (default: CPU core count)",
+    },
+    {
+        .cmd  = "-HOBJ=NAME",
+        .desc = "Show the size of an object file over the last builds",
+    },
+    {
+        .cmd  = "-HLAST=N",
+        .desc = "Number of builds shown by -HOBJ (default: 20)",
+    },
+    {
+        .cmd  = "-HREGION=NAME:PERCENT",
+        .desc = "Find the first build where an execution region reached the usage percent",
+    },
+#if defined(ENABLE_BENCHMARK) && (ENABLE_BENCHMARK != 0)
+    {
+        .cmd  = "-BENCH",
+        .desc = "Run the parser benchmark on the map file and a generated large map",
+    },
+#endif
 };
 
 
@@ -111,10 +151,16 @@ int main(int argc, char *argv[])
 {
     clock_t run_time = clock();
 
-    struct load_region *load_region_head = NULL;
-    struct object_info *object_info_head = NULL;
-    struct load_region *record_load_region_head = NULL;
-    struct object_info *record_object_info_head = NULL;
+    char *file_path                = NULL;
+    struct project_job *jobs       = NULL;
+    size_t job_qty                 = 0;
+    struct file_mapping *mappings  = NULL;
+    size_t mapping_qty             = 0;
+    struct record_store record_store = {0};
+    struct record_store cache_store  = {0};
+    struct record_store model_store  = {0};
+    struct record_store_item *items  = NULL;
+    struct history history           = {0};
 
     /* 获取编码格式 */
     UINT acp = GetACP();
@@ -127,6 +173,12 @@ int main(int argc, char *argv[])
     else {
         _encoding_type = ENCODING_TYPE_OTHER;
     }
+    keyword_matcher_init(&_keyword_matcher);
+    intern_table_init(&_intern_table);
+
+    /* 选择 CPU 支持的最快的文本扫描函数 */
+    struct scan_kernel kernels[SCAN_KERNEL_QTY];
+    _scan = kernels[scan_kernel_list(kernels, SCAN_KERNEL_QTY) - 1];
 
     /* 1. 获取程序运行的工作目录 */
     int result = 0;
@@ -134,7 +186,7 @@ int main(int argc, char *argv[])
     if (buff_len == 0) 
     {
         printf("\n[ERROR] %s %s\n", APP_NAME, APP_VERSION);
-        printf("[ERROR] Get current directory length failed (code: %d)\n", GetLastError());
+        printf("[ERROR] Get current directory length failed (code: %lu)\n", GetLastError());
         result = -20;
         goto __exit;
     }
@@ -152,13 +204,12 @@ int main(int argc, char *argv[])
     if (buff_len == 0) 
     {
         printf("\n[ERROR] %s %s\n", APP_NAME, APP_VERSION);
-        printf("[ERROR] Get current directory failed. (code: %d)\n", GetLastError());
+        printf("[ERROR] Get current directory failed. (code: %lu)\n", GetLastError());
         result = -22;
         goto __exit;
     }
 
     /* 创建 log 文件 */
-    char *file_path = NULL;
     size_t file_path_size = 0;
 
     if (buff_len < MAX_PATH) {
@@ -175,9 +226,9 @@ int main(int argc, char *argv[])
         goto __exit;
     }
     snprintf(file_path, file_path_size, "%s\\%s.log", _current_dir, APP_NAME);
-    _log_file = fopen(file_path, "w+");
+    _log_file.file = fopen(file_path, "w+");
 
-    log_print(_log_file, "\n=================================================== %s %s ==================================================\n ", APP_NAME, APP_VERSION);
+    log_print(&_log_file, "\n=================================================== %s %s ==================================================\n ", APP_NAME, APP_VERSION);
 
     /* 2. 搜索同级目录或指定目录下的所有 keil 工程并打印 */
     _keil_prj_path_list = prj_path_list_init(MAX_PATH_QTY);
@@ -189,11 +240,11 @@ int main(int argc, char *argv[])
                               _keil_prj_path_list);
 
     if (_keil_prj_path_list->size > 0) {
-        log_save(_log_file, "\n[Search keil project] %d item(s)\n", _keil_prj_path_list->size);
+        log_save(&_log_file, "\n[Search keil project] %zu item(s)\n", _keil_prj_path_list->size);
     }
 
     for (size_t i = 0; i < _keil_prj_path_list->size; i++) {
-        log_save(_log_file, "\t%s\n", _keil_prj_path_list->items[i]);
+        log_save(&_log_file, "\t%s\n", _keil_prj_path_list->items[i]);
     }
 
     /* 3. 参数处理 */
@@ -211,76 +262,389 @@ int main(int argc, char *argv[])
                                     &err_param);
         if (res == -1)
         {
-            log_print(_log_file, "\n[ERROR] INVALID INPUT (code: %d): %s\n", GetLastError(), argv[1]);
+            log_print(&_log_file, "\n[ERROR] INVALID INPUT (code: %lu): %s\n", GetLastError(), argv[1]);
             result = -1;
             goto __exit;
         }
         else if (res == -2)
         {
-            log_print(_log_file, "\n[ERROR] INVALID INPUT: %s\n", argv[1]);
-            log_print(_log_file, "[ERROR] Please enter the absolute path or keil project name with extension\n");
+            log_print(&_log_file, "\n[ERROR] INVALID INPUT: %s\n", argv[1]);
+            log_print(&_log_file, "[ERROR] Please enter the absolute path or keil project name with extension\n");
             result = -2;
             goto __exit;
         }
         else if (res == -3)
         {
-            log_print(_log_file, "\n[ERROR] INVALID INPUT: %s\n", argv[err_param]);
-            log_print(_log_file, "[ERROR] Only the following commands are supported\n");
+            log_print(&_log_file, "\n[ERROR] INVALID INPUT: %s\n", argv[err_param]);
+            log_print(&_log_file, "[ERROR] Only the following commands are supported\n");
             for (size_t i = 0; i < sizeof(_command_list) / sizeof(struct command_list); i++) {
-                log_print(_log_file, "\t%s\t %s\n", _command_list[i].cmd, _command_list[i].desc);
+                log_print(&_log_file, "\t%s\t %s\n", _command_list[i].cmd, _command_list[i].desc);
             }
             result = -3;
             goto __exit;
         }
         else if (res == -4)
         {
-            log_print(_log_file, "\nYou can control the displayed information by entering the following commands\n \n");
+            log_print(&_log_file, "\nYou can control the displayed information by entering the following commands\n \n");
             for (size_t i = 0; i < sizeof(_command_list) / sizeof(struct command_list); i++) {
-                log_print(_log_file, "\t%s\t %s\n", _command_list[i].cmd, _command_list[i].desc);
+                log_print(&_log_file, "\t%s\t %s\n", _command_list[i].cmd, _command_list[i].desc);
             }
             result = 0;
             goto __exit;
         }
     }
 
-    log_save(_log_file, "\n[User input] %s\n", input_param);
-    log_save(_log_file, "[Current folder] %s\n", _current_dir);
-    log_save(_log_file, "[Encoding] %d\n", acp);
+    log_save(&_log_file, "\n[User input] %s\n", input_param);
+    log_save(&_log_file, "[Current folder] %s\n", _current_dir);
+    log_save(&_log_file, "[Encoding] %d\n", acp);
 
     /* 4. 确定 keil 工程 */
-    char *keil_prj_path;
-    if (input_param[0] != '\0')
+    if (_is_all_project)
     {
-        log_print(_log_file, "\n[Hint] You specify the keil project!\n");
-        keil_prj_path = input_param;
+        if (_keil_prj_path_list->size == 0)
+        {
+            log_print(&_log_file, "\n[ERROR] NO keil project found\n");
+            log_print(&_log_file, "[ERROR] Please check: %s\n", _current_dir);
+            result = -4;
+            goto __exit;
+        }
+        job_qty = _keil_prj_path_list->size;
+    }
+    else {
+        job_qty = 1;
     }
-    else if (_keil_prj_path_list->size > 0)
+
+    jobs = (struct project_job *)calloc(job_qty, sizeof(struct project_job));
+    if (jobs == NULL)
     {
-        keil_prj_path = _keil_prj_path_list->items[_keil_prj_path_list->size - 1];
+        log_print(&_log_file, "\n[ERROR] Failed to allocate project job memory\n");
+        result = -26;
+        goto __exit;
+    }
 
-        char *last_slash = strrchr(keil_prj_path, '\\');
-        if (last_slash) 
+    if (_is_all_project)
+    {
+        /* 分析搜索到的全部 keil 工程，各工程的输出暂存后按搜索顺序输出 */
+        for (size_t i = 0; i < job_qty; i++)
         {
-            last_slash += 1;
-            strncpy_s(keil_prj_name, sizeof(keil_prj_name), last_slash, strnlen(last_slash, sizeof(keil_prj_name)));
+            char *prj_path   = _keil_prj_path_list->items[i];
+            char *last_slash = strrchr(prj_path, '\\');
+
+            strncpy_s(jobs[i].prj_path, sizeof(jobs[i].prj_path), prj_path, strnlen_s(prj_path, sizeof(jobs[i].prj_path)));
+            if (last_slash) 
+            {
+                last_slash += 1;
+                strncpy_s(jobs[i].prj_name, sizeof(jobs[i].prj_name), last_slash, strnlen_s(last_slash, sizeof(jobs[i].prj_name)));
+            }
+            jobs[i].is_batch        = true;
+            jobs[i].log.file        = _log_file.file;
+            jobs[i].log.is_buffered = true;
         }
     }
     else
     {
-        log_print(_log_file, "\n[ERROR] NO keil project found\n");
-        log_print(_log_file, "[ERROR] Please check: %s\n", input_param);
-        result = -4;
+        char *keil_prj_path;
+        if (input_param[0] != '\0')
+        {
+            log_print(&_log_file, "\n[Hint] You specify the keil project!\n");
+            keil_prj_path = input_param;
+        }
+        else if (_keil_prj_path_list->size > 0)
+        {
+            keil_prj_path = _keil_prj_path_list->items[_keil_prj_path_list->size - 1];
+
+            char *last_slash = strrchr(keil_prj_path, '\\');
+            if (last_slash) 
+            {
+                last_slash += 1;
+                strncpy_s(keil_prj_name, sizeof(keil_prj_name), last_slash, strnlen(last_slash, sizeof(keil_prj_name)));
+            }
+        }
+        else
+        {
+            log_print(&_log_file, "\n[ERROR] NO keil project found\n");
+            log_print(&_log_file, "[ERROR] Please check: %s\n", input_param);
+            result = -4;
+            goto __exit;
+        }
+
+        strncpy_s(jobs[0].prj_path, sizeof(jobs[0].prj_path), keil_prj_path, strnlen_s(keil_prj_path, sizeof(jobs[0].prj_path)));
+        strncpy_s(jobs[0].prj_name, sizeof(jobs[0].prj_name), keil_prj_name, strnlen_s(keil_prj_name, sizeof(jobs[0].prj_name)));
+        jobs[0].is_batch        = false;
+        jobs[0].log.file        = _log_file.file;
+        jobs[0].log.is_buffered = true;     /* 打印的内容同时保存到分析缓存 */
+    }
+
+    /* 将各工程展开为各 target 的分析任务，uvprojx 文件的映射保留至分析完成 */
+    if (_is_all_target)
+    {
+        mapping_qty = job_qty;
+        mappings    = (struct file_mapping *)calloc(mapping_qty, sizeof(struct file_mapping));
+        if (mappings == NULL 
+            || project_target_expand(&jobs, &job_qty, mappings) != 0)
+        {
+            log_print(&_log_file, "\n[ERROR] Failed to allocate project job memory\n");
+            result = -26;
+            goto __exit;
+        }
+    }
+
+    /* 打开记录文件，所有工程及 target 共用，按 key 查找各自的记录 */
+    snprintf(file_path, file_path_size, "%s\\%s-record.bin", _current_dir, APP_NAME);
+    int res = record_store_open(&record_store, file_path, RECORD_STORE_MAGIC);
+    if (res == -2) {
+        log_print(&_log_file, "\n[WARNING] record file is invalid or out of date, it will be rebuilt\n");
+    }
+    else if (res == -3) {
+        log_print(&_log_file, "\n[WARNING] Failed to allocate record index memory, the record is ignored\n");
+    }
+
+    /* 打开分析缓存文件，无效时全部重新分析 */
+    snprintf(file_path, file_path_size, "%s\\%s-cache.bin", _current_dir, APP_NAME);
+    record_store_open(&cache_store, file_path, CACHE_STORE_MAGIC);
+
+    /* 打开工程模型文件，无效时全部重新解析 */
+    snprintf(file_path, file_path_size, "%s\\%s-model.bin", _current_dir, APP_NAME);
+    record_store_open(&model_store, file_path, MODEL_STORE_MAGIC);
+
+    for (size_t i = 0; i < job_qty; i++) 
+    {
+        jobs[i].record_store = &record_store;
+        jobs[i].cache_store  = &cache_store;
+        jobs[i].model_store  = &model_store;
+    }
+
+    /* 4.1 分析 keil 工程 */
+    if (_is_all_project || _is_all_target) 
+    {
+        size_t worker_qty = _worker_qty;
+        if (worker_qty == 0)
+        {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            worker_qty = info.dwNumberOfProcessors;
+        }
+        if (worker_qty > job_qty) {
+            worker_qty = job_qty;
+        }
+        log_print(&_log_file, "\n[Hint] Analyze %zu keil %s with %zu worker(s)\n", 
+                  job_qty, _is_all_target ? "target(s)" : "project(s)", worker_qty);
+        project_pool_run(jobs, job_qty, worker_qty);
+    }
+    else {
+        jobs[0].result = project_process(&jobs[0]);
+    }
+
+    /* 4.2 按固定顺序输出各工程的结果，返回第一个错误 */
+    for (size_t i = 0; i < job_qty; i++)
+    {
+        log_file_flush(&_log_file, &jobs[i].log);
+        if (result == 0) {
+            result = jobs[i].result;
+        }
+    }
+
+    /* 4.3 保存本次的记录及分析缓存，未更新的条目原样保留 */
+    items = (struct record_store_item *)calloc(job_qty, sizeof(struct record_store_item));
+    for (size_t i = 0; i < job_qty && items; i++) 
+    {
+        items[i].key   = jobs[i].record_key;
+        items[i].image = &jobs[i].record_image;
+    }
+
+    /* 其他实例占用记录文件时不保存本次的记录，不影响本次构建 */
+    snprintf(file_path, file_path_size, "%s\\%s-record.bin", _current_dir, APP_NAME);
+    res = items ? record_store_save(&record_store, file_path, RECORD_STORE_MAGIC, items, job_qty) : -1;
+    if (res == -4 || res == -5)
+    {
+        log_print(&_log_file, "\n[WARNING] record file is in use, this build is not saved as the baseline\n");
+        log_print(&_log_file, "[WARNING] Please check: %s\n", file_path);
+    }
+    else if (res != 0)
+    {
+        log_print(&_log_file, "\n[ERROR] can't create record file\n");
+        log_print(&_log_file, "[ERROR] Please check: %s\n", file_path);
+        if (result == 0) {
+            result = -19;
+        }
+    }
+
+    for (size_t i = 0; i < job_qty && items; i++) 
+    {
+        items[i].key   = jobs[i].cache_key;
+        items[i].image = &jobs[i].cache_image;
+    }
+
+    snprintf(file_path, file_path_size, "%s\\%s-cache.bin", _current_dir, APP_NAME);
+    if (items == NULL 
+    ||  record_store_save(&cache_store, file_path, CACHE_STORE_MAGIC, items, job_qty) != 0)
+    {
+        log_print(&_log_file, "\n[WARNING] can't create cache file\n");
+        log_print(&_log_file, "[WARNING] Please check: %s\n", file_path);
+    }
+
+    for (size_t i = 0; i < job_qty && items; i++) 
+    {
+        items[i].key   = jobs[i].cache_key;
+        items[i].image = &jobs[i].model_image;
+    }
+
+    snprintf(file_path, file_path_size, "%s\\%s-model.bin", _current_dir, APP_NAME);
+    if (items == NULL 
+    ||  record_store_save(&model_store, file_path, MODEL_STORE_MAGIC, items, job_qty) != 0)
+    {
+        log_print(&_log_file, "\n[WARNING] can't create project model file\n");
+        log_print(&_log_file, "[WARNING] Please check: %s\n", file_path);
+    }
+
+    /* 4.4 追加本次的构建历史，并按参数查询。其他实例可能同时追加，加锁后读取有效内容的大小 */
+    snprintf(file_path, file_path_size, "%s\\%s-history.bin", _current_dir, APP_NAME);
+    HANDLE history_lock = record_store_lock(file_path);
+    if (history_lock == INVALID_HANDLE_VALUE)
+    {
+        log_print(&_log_file, "\n[WARNING] history file is in use, this build is not saved to history\n");
+        log_print(&_log_file, "[WARNING] Please check: %s\n", file_path);
+    }
+    else
+    {
+        res = history_open(&history, file_path);
+        bool is_appendable = (res == 0);
+        if (res == -1) 
+        {
+            /* 文件不存在时新建，存在但无法打开时不追加以免覆盖历史 */
+            is_appendable = (GetFileAttributes(file_path) == INVALID_FILE_ATTRIBUTES);
+        }
+        else if (res == -2) 
+        {
+            /* 无效或版本不符的文件改名保留后重建 */
+            is_appendable = history_file_backup(file_path);
+            if (is_appendable) {
+                log_print(&_log_file, "\n[WARNING] history file is invalid or out of date, it is renamed to %s.old\n", file_path);
+            }
+        }
+
+        /* 内存不足时无法确定有效内容的大小，不追加以免覆盖历史 */
+        if (is_appendable == false || history_append(&history, file_path, jobs, job_qty) != 0)
+        {
+            log_print(&_log_file, "\n[WARNING] can't write history file\n");
+            log_print(&_log_file, "[WARNING] Please check: %s\n", file_path);
+        }
+        history_close(&history);
+        CloseHandle(history_lock);
+    }
+
+    if ((_history_object[0] != '\0' || _history_region[0] != '\0')
+    &&  history_open(&history, file_path) == 0)
+    {
+        for (size_t i = 0; i < job_qty; i++)
+        {
+            const struct history_series *series = hash_table_find(&history.key_index, jobs[i].record_key);
+            if (series == NULL) {
+                continue;
+            }
+
+            if (_history_object[0] != '\0') {
+                history_object_print(&_log_file, &history, series, _history_object, _history_build_qty);
+            }
+            if (_history_region[0] != '\0') {
+                history_region_print(&_log_file, &history, series, _history_region, _history_percent);
+            }
+        }
+        log_print(&_log_file, "\n");
+    }
+
+__exit:
+    if (_current_dir) {
+        free(_current_dir);
+    }
+    if (file_path) {
+        free(file_path);
+    }
+    if (jobs) 
+    {
+        for (size_t i = 0; i < job_qty; i++) 
+        {
+            text_buffer_free(&jobs[i].record_image);
+            text_buffer_free(&jobs[i].history_build);
+            text_buffer_free(&jobs[i].cache_image);
+            text_buffer_free(&jobs[i].model_image);
+        }
+        free(jobs);
+    }
+    free(items);
+    record_store_close(&record_store);
+    record_store_close(&cache_store);
+    record_store_close(&model_store);
+    history_close(&history);
+    if (mappings)
+    {
+        for (size_t i = 0; i < mapping_qty; i++) 
+        {
+            if (mappings[i].data) {
+                file_mapping_close(&mappings[i]);
+            }
+        }
+        free(mappings);
+    }
+    prj_path_list_free(_keil_prj_path_list);
+    intern_table_free(&_intern_table);
+
+    log_print(&_log_file, "=============================================================================================================================\n\n");
+    log_save(&_log_file, "run time: %.3f s\n", (double)(clock() - run_time) / CLOCKS_PER_SEC);
+    fclose(_log_file.file);
+    return result;
+}
+
+
+/**
+ * @brief  分析单个 keil 工程
+ * @note   可在多个线程中同时调用，工程之间除 intern 表外不共享可变的状态
+ * @param  job: 工程分析任务
+ * @retval 0: 正常 | -x: 错误
+ */
+int project_process(struct project_job *job)
+{
+    LARGE_INTEGER freq, start, stop;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&start);
+
+    int result                = 0;
+    struct log_file *log      = &job->log;
+    const char *keil_prj_path = job->prj_path;
+    char keil_prj_name[MAX_PRJ_NAME_SIZE] = {0};
+    strncpy_s(keil_prj_name, sizeof(keil_prj_name), job->prj_name, strnlen_s(job->prj_name, sizeof(keil_prj_name)));
+
+    struct parse_context ctx;
+    parse_context_init(&ctx);
+    ctx.log = log;
+
+    struct region_list load_region_list = {0};
+    struct object_list object_info_list = {0};
+    struct record_view record           = {0};
+    struct cache_input_list inputs      = {0};
+
+    size_t file_path_size = strlen(_current_dir);
+    if (file_path_size < MAX_PATH) {
+        file_path_size = MAX_PATH * 2;
+    } else {
+        file_path_size = file_path_size * 2;
+    }
+    char *file_path = (char *)malloc(file_path_size);
+    if (file_path == NULL) 
+    {
+        log_print(log, "\n[ERROR] Failed to allocate file path memory\n");
+        result = -23;
         goto __exit;
     }
 
-    log_save(_log_file, "[Keil project path] %s\n", keil_prj_path);
-    log_save(_log_file, "[Keil project name] %s\n", keil_prj_name);
+    log_save(log, "[Keil project path] %s\n", keil_prj_path);
+    log_save(log, "[Keil project name] %s\n", keil_prj_name);
 
     bool is_keil4_prj = false;
     if (keil_prj_name[strlen(keil_prj_name) - 1] == 'j') {
         is_keil4_prj = true;
     }
-    log_save(_log_file, "[Is keil v4] %d\n", is_keil4_prj);
+    log_save(log, "[Is keil v4] %d\n", is_keil4_prj);
 
     char keil_prj_full_name[MAX_PRJ_NAME_SIZE] = {0};
     memcpy_s(keil_prj_full_name, sizeof(keil_prj_full_name), keil_prj_name, strnlen_s(keil_prj_name, sizeof(keil_prj_full_name)));
@@ -289,6 +653,20 @@ int main(int argc, char *argv[])
         *dot = '\0';
     }
 
+    /* 输入文件、参数及上次的记录均未改变时，直接重放上次的分析结果 */
+    if (job->target_index) {
+        snprintf(job->cache_key, sizeof(job->cache_key), "%s#%zu", keil_prj_full_name, job->target_index);
+    } else {
+        strncpy_s(job->cache_key, sizeof(job->cache_key), keil_prj_full_name, strnlen_s(keil_prj_full_name, sizeof(keil_prj_full_name)));
+    }
+    log_save(log, "[cache key] %s\n", job->cache_key);
+
+    if (cache_replay(job))
+    {
+        log_save(log, "\n[cache] inputs are unchanged, the last result is replayed\n");
+        goto __exit;
+    }
+
     /* 5. 获取启用的 project target */
     /* 打开同名的 .uvoptx 或 .uvopt 文件 */
     char target_name[MAX_PRJ_NAME_SIZE] = {0};
@@ -297,13 +675,45 @@ int main(int argc, char *argv[])
         strncat_s(file_path, file_path_size, "x", 1);
     }
 
+    /* uvoptx 及 uvprojx 文件均未改变时使用缓存的工程模型，无需解析 */
+    struct uvprojx_info uvprojx_file = {0};
+    bool is_has_target   = true;
+    bool is_model_cached = model_load(job, 
+                                      &ctx, 
+                                      &inputs, 
+                                      target_name, 
+                                      sizeof(target_name), 
+                                      &is_has_target, 
+                                      &uvprojx_file);
+    if (is_model_cached) {
+        log_save(log, "[model] the project model is loaded from cache\n");
+    }
+
+    /* 已指定 target 的区间时无需读取 uvoptx 文件，target name 从区间中获取 */
     /* 不存在 uvoptx 文件时，默认选择第一个 target name */
-    bool is_has_target = true;
-    if (uvoptx_file_process(file_path, target_name, sizeof(target_name)) == false) 
-    {
+    int res = 0;
+    if (is_model_cached == false && job->target_range.start) {
         is_has_target = false;
-        log_print(_log_file, "\n[WARNING] can't open '%s'\n", file_path);
-        log_print(_log_file, "[WARNING] The first project target is selected by default.\n");
+    }
+    else if (is_model_cached == false)
+    {
+        cache_input_add(&ctx, &inputs, file_path, NULL);
+        res = uvoptx_file_process(&ctx, file_path, target_name, sizeof(target_name));
+        if (res == -2)
+        {
+            log_print(log, "\n[ERROR] target name is longer than %d characters\n", MAX_PRJ_NAME_SIZE - 1);
+            log_print(log, "[ERROR] Please check: %s\n", file_path);
+            result = -27;
+            goto __exit;
+        }
+        else if (res != 0) {
+            is_has_target = false;
+        }
+    }
+    if (is_has_target == false && job->target_range.start == NULL)
+    {
+        log_print(log, "\n[WARNING] can't open '%s'\n", file_path);
+        log_print(log, "[WARNING] The first project target is selected by default.\n");
     }
 
     /* 6. 获取 map 和 htm 文件所在的目录及 device 和 output_name 信息 */
@@ -313,61 +723,83 @@ int main(int argc, char *argv[])
         strncat_s(file_path, file_path_size, "x", 1);
     }
     
-    char target_name_label[MAX_PRJ_NAME_SIZE * 2] = {0};
-
-    if (is_has_target) {
-        snprintf(target_name_label, sizeof(target_name_label), "%s%s", LABEL_TARGET_NAME, target_name);    
-    } else {
-        strncpy_s(target_name_label, sizeof(target_name_label), LABEL_TARGET_NAME, strlen(LABEL_TARGET_NAME));
-    }
-
-    struct uvprojx_info uvprojx_file = {0};
-    int res = uvprojx_file_process(file_path, 
-                                   target_name_label, 
-                                   &uvprojx_file, 
-                                   !is_has_target);
-    if (res == -1)
-    {
-        log_print(_log_file, "\n[ERROR] can't open .uvproj(x) file\n");
-        log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
-        result = -5;
-        goto __exit;
-    }
-    else if (res == -2)
+    if (is_model_cached == false)
     {
-        log_print(_log_file, "\n[ERROR] <Cpu> contains unsupported types\n");
-        log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
-        result = -6;
-        goto __exit;
-    }
-    else if (res == -3)
-    {
-        log_print(_log_file, "\n[ERROR] generate map file is not checked (Options for Target -> Listing -> Linker Listing)\n");
-        result = -7;
-        goto __exit;
+        cache_input_add(&ctx, &inputs, file_path, NULL);
+        if (job->target_range.start)
+        {
+            res = uvprojx_target_process(&ctx,
+                                         &job->target_range, 
+                                         target_name, 
+                                         &uvprojx_file, 
+                                         true);
+        }
+        else 
+        {
+            res = uvprojx_file_process(&ctx,
+                                       file_path, 
+                                       target_name, 
+                                       &uvprojx_file, 
+                                       !is_has_target);
+        }
+        if (res == -1)
+        {
+            log_print(log, "\n[ERROR] can't open .uvproj(x) file\n");
+            log_print(log, "[ERROR] Please check: %s\n", file_path);
+            result = -5;
+            goto __exit;
+        }
+        else if (res == -2)
+        {
+            log_print(log, "\n[ERROR] <Cpu> contains unsupported types\n");
+            log_print(log, "[ERROR] Please check: %s\n", file_path);
+            result = -6;
+            goto __exit;
+        }
+        else if (res == -3)
+        {
+            log_print(log, "\n[ERROR] generate map file is not checked (Options for Target -> Listing -> Linker Listing)\n");
+            result = -7;
+            goto __exit;
+        }
+        else if (res == -4)
+        {
+            log_print(log, "\n[ERROR] target name, output name or path is too long (name: %d, path: %d characters at most)\n", 
+                      MAX_PRJ_NAME_SIZE - 1, MAX_PATH - 1);
+            log_print(log, "[ERROR] Please check: %s\n", file_path);
+            result = -27;
+            goto __exit;
+        }
+
+        /* 保存本次解析的工程模型，重命名在每次分析时按 build_log 文件重新处理 */
+        if (model_image_build(job, &ctx, &inputs, target_name, is_has_target, &uvprojx_file) == false)
+        {
+            text_buffer_free(&job->model_image);
+            log_save(log, "\n[WARNING] Failed to create project model cache\n");
+        }
     }
 
-    log_save(_log_file, "\n[Device] %s\n", uvprojx_file.chip);
-    log_save(_log_file, "[Target name] %s\n", uvprojx_file.target_name);
-    log_save(_log_file, "[Output name] %s\n", uvprojx_file.output_name);
-    log_save(_log_file, "[Output path] %s\n", uvprojx_file.output_path);
-    log_save(_log_file, "[Listing path] %s\n", uvprojx_file.listing_path);
-    log_save(_log_file, "[Is has pack] %d\n", uvprojx_file.is_has_pack);
-    log_save(_log_file, "[Is enbale LTO] %d\n", uvprojx_file.is_enable_lto);
-    log_save(_log_file, "[Is has user library] %d\n", uvprojx_file.is_has_user_lib);
-    log_save(_log_file, "[Is custom scatter file] %d\n", uvprojx_file.is_custom_scatter);
+    log_save(log, "\n[Device] %s\n", uvprojx_file.chip);
+    log_save(log, "[Target name] %s\n", uvprojx_file.target_name);
+    log_save(log, "[Output name] %s\n", uvprojx_file.output_name);
+    log_save(log, "[Output path] %s\n", uvprojx_file.output_path);
+    log_save(log, "[Listing path] %s\n", uvprojx_file.listing_path);
+    log_save(log, "[Is has pack] %d\n", uvprojx_file.is_has_pack);
+    log_save(log, "[Is enbale LTO] %d\n", uvprojx_file.is_enable_lto);
+    log_save(log, "[Is has user library] %d\n", uvprojx_file.is_has_user_lib);
+    log_save(log, "[Is custom scatter file] %d\n", uvprojx_file.is_custom_scatter);
 
     if (uvprojx_file.output_name[0] == '\0') 
     {
-        log_print(_log_file, "\n[ERROR] output name is empty\n");
-        log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
+        log_print(log, "\n[ERROR] output name is empty\n");
+        log_print(log, "[ERROR] Please check: %s\n", file_path);
         result = -8;
         goto __exit;
     }
     if (uvprojx_file.listing_path[0] == '\0') 
     {
-        log_print(_log_file, "\n[ERROR] listing path is empty\n");
-        log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
+        log_print(log, "\n[ERROR] listing path is empty\n");
+        log_print(log, "[ERROR] Please check: %s\n", file_path);
         result = -9;
         goto __exit;
     }
@@ -376,14 +808,14 @@ int main(int argc, char *argv[])
     if (is_has_target == false) {
         p_target_name = uvprojx_file.target_name;
     }
-    log_print(_log_file, "\n[%s]  [%s]  [%s]\n \n", keil_prj_full_name, p_target_name, uvprojx_file.chip);
+    log_print(log, "\n[%s]  [%s]  [%s]\n \n", keil_prj_full_name, p_target_name, uvprojx_file.chip);
 
-    log_save(_log_file, "[memory info]\n");
-    for (struct memory_info *memory = _memory_info_head; 
+    log_save(log, "[memory info]\n");
+    for (struct memory_info *memory = ctx.memory_list.head; 
          memory != NULL; 
          memory = memory->next)
     {
-        log_save(_log_file, "[name] %s [base addr] 0x%.8X [size] 0x%.8X [type] %d [off-chip] %d [is pack] %d [ID] %d \n", 
+        log_save(log, "[name] %s [base addr] 0x%.8X [size] 0x%.8X [type] %d [off-chip] %d [is pack] %d [ID] %zu \n", 
                  memory->name, memory->base_addr, memory->size, memory->type, memory->is_offchip, memory->is_from_pack, memory->id);
     }
 
@@ -394,82 +826,103 @@ int main(int argc, char *argv[])
         snprintf(file_path, file_path_size, "%s%s.build_log.htm", file_path, uvprojx_file.output_name);
         if (res == 0)
         {
-            build_log_file_process(file_path);
+            cache_input_add(&ctx, &inputs, file_path, NULL);
+            build_log_file_process(&ctx, file_path);
         }
         if (res == -1)
         {
-            log_print(_log_file, "\n[WARNING] %s not a absolute path\n", keil_prj_path);
-            log_print(_log_file, "[WARNING] path: %s\n \n", file_path);
+            log_print(log, "\n[WARNING] %s not a absolute path\n", keil_prj_path);
+            log_print(log, "[WARNING] path: %s\n \n", file_path);
         }
         else if (res == -2)
         {
-            log_print(_log_file, "\n[WARNING] relative paths go up more levels than absolute paths\n");
-            log_print(_log_file, "[WARNING] path: %s\n \n", file_path);
+            log_print(log, "\n[WARNING] relative paths go up more levels than absolute paths\n");
+            log_print(log, "[WARNING] path: %s\n \n", file_path);
         }
     }
     else {
-        log_print(_log_file, "\n[WARNING] %s is empty, can't read '.build_log.htm' file\n \n", LABEL_OUTPUT_DIRECTORY);
+        log_print(log, "\n[WARNING] <%s> is empty, can't read '.build_log.htm' file\n \n", LABEL_OUTPUT_DIRECTORY);
     }
 
     /* 8. 处理剩余的重名文件 */
-    file_rename_process();
+    file_rename_process(&ctx);
+
+    /* 文件名已确定，建立 object 与文件的匹配索引 */
+    if (file_path_index_build(&ctx.file_path_index, &ctx.file_list) == false)
+    {
+        log_print(log, "\n[ERROR] Failed to allocate file index memory\n");
+        result = -24;
+        goto __exit;
+    }
 
     /* 9. 打开 map 文件，获取 Load Region 和 Execution Region */
     res = combine_path(file_path, file_path_size, keil_prj_path, uvprojx_file.listing_path);
     if (res == -1)
     {
-        log_print(_log_file, "\n[ERROR] %s not a absolute path\n \n", keil_prj_path);
+        log_print(log, "\n[ERROR] %s not a absolute path\n \n", keil_prj_path);
         result = -10;
         goto __exit;
     }
     else if (res == -2)
     {
-        log_print(_log_file, "\n[ERROR] relative paths go up more levels than absolute paths\n \n");
+        log_print(log, "\n[ERROR] relative paths go up more levels than absolute paths\n \n");
         result = -11;
         goto __exit;
     }
 
     snprintf(file_path, file_path_size, "%s%s.map", file_path, uvprojx_file.output_name);
-    log_save(_log_file, "[map file path] %s\n", file_path);
+    log_save(log, "[map file path] %s\n", file_path);
+    cache_input_add(&ctx, &inputs, file_path, NULL);
+
+#if defined(ENABLE_BENCHMARK) && (ENABLE_BENCHMARK != 0)
+    if (_is_benchmark) {
+        benchmark_process(log, file_path);
+    }
+#endif
+
+    /* 不显示 object 或开启了 LTO 时无需解析 Image component sizes */
+    bool is_get_object = (_is_display_object && uvprojx_file.is_enable_lto == false);
 
-    res = map_file_process(file_path, 
-                           &load_region_head, 
-                           &object_info_head, 
+    res = map_file_process(&ctx,
+                           file_path, 
+                           &load_region_list, 
+                           &object_info_list, 
+                           is_get_object,
                            uvprojx_file.is_has_user_lib,
                            true);   /* !uvprojx_file.is_custom_scatter */
     if (res == -1)
     {
-        log_print(_log_file, "\n[ERROR] Check if a map file exists (Options for Target -> Listing -> Linker Listing)\n");
-        log_print(_log_file, "[ERROR] map file path: %s\n", file_path);
+        log_print(log, "\n[ERROR] Check if a map file exists (Options for Target -> Listing -> Linker Listing)\n");
+        log_print(log, "[ERROR] map file path: %s\n", file_path);
         result = -12;
         goto __exit;
     }
     else if (res == -2)
     {
-        log_print(_log_file, "\n[ERROR] map file does not contain \"%s\"\n", STR_MEMORY_MAP_OF_THE_IMAGE);
-        log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
+        log_print(log, "\n[ERROR] map file does not contain \"%s\"\n", STR_MEMORY_MAP_OF_THE_IMAGE);
+        log_print(log, "[ERROR] Please check: %s\n", file_path);
         result = -13;
         goto __exit;
     }
     else if (res == -3)
     {
-        log_print(_log_file, "\n[ERROR] map file does not find object's information\n");
-        log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
+        log_print(log, "\n[ERROR] map file does not find object's information\n");
+        log_print(log, "[ERROR] Please check: %s\n", file_path);
         result = -14;
         goto __exit;
     }
 
-    log_save(_log_file, "\n[region info]\n");
-    for (struct load_region *l_region = load_region_head; 
+    log_save(log, "\n[region info]\n");
+    for (struct load_region *l_region = load_region_list.head; 
          l_region != NULL; 
          l_region = l_region->next)
     {
-        log_save(_log_file, "[load region] %s\n", l_region->name);
+        log_save(log, "[load region] %s\n", l_region->name);
         for (struct exec_region *e_region = l_region->exec_region; 
              e_region != NULL; 
              e_region = e_region->next)
         {
-            log_save(_log_file, "\t[execution region] %s, 0x%.8X, 0x%.8X, 0x%.8X [memory type] %d [memory ID] %d\n", 
+            log_save(log, "\t[execution region] %s, 0x%.8X, 0x%.8X, 0x%.8X [memory type] %d [memory ID] %zu\n", 
                      e_region->name, e_region->base_addr, e_region->size, 
                      e_region->used_size, e_region->memory_type, e_region->memory_id);
             
@@ -477,43 +930,35 @@ int main(int argc, char *argv[])
                  block != NULL;
                  block = block->next)
             {
-                log_save(_log_file, "\t\t[ZI block] addr: 0x%.8X, size: 0x%.8X (%d)\n", 
+                log_save(log, "\t\t[ZI block] addr: 0x%.8X, size: 0x%.8X (%d)\n", 
                          block->start_addr, block->size, block->size);
             }
-            log_save(_log_file, "\n");
+            log_save(log, "\n");
         }
     }
 
     /* 10. 打印用户 object 和用户 library 文件的 flash 和 RAM 占用情况 */
     /* 10.1 将路径绑定到 object info 对应的 path 成员 */
+    for (struct object_info *object_temp = object_info_list.head;
+         object_temp != NULL;
+         object_temp = object_temp->next)
+    {
+        struct file_path_list *path_temp = hash_table_find(&ctx.file_path_index.object, object_temp->name);
+        if (path_temp) {
+            object_temp->path = path_temp->path;
+        }
+    }
+
     size_t max_name_len = 0;
     size_t max_path_len = 0;
-    for (struct file_path_list *path_temp = _file_path_list_head;
+    for (struct file_path_list *path_temp = ctx.file_list.head;
          path_temp != NULL;
          path_temp = path_temp->next)
     {
-        for (struct object_info *object_temp = object_info_head;
-             object_temp != NULL;
-             object_temp = object_temp->next)
-        {
-            if (path_temp->file_type == OBJECT_FILE_TYPE_LIBRARY)
-            {
-                if (strcasecmp(object_temp->name, path_temp->old_name) == 0) {
-                    object_temp->path = path_temp->path;
-                }
-            }
-            else 
-            {
-                if (strcasecmp(object_temp->name, path_temp->new_object_name) == 0) {
-                    object_temp->path = path_temp->path;
-                }
-            }
-        }
-
         /* 计算出各个文件名称和相对路径的最长长度 */
-        size_t path_len  = strnlen_s(path_temp->path, MAX_PATH);
-        size_t name_len1 = strnlen_s(path_temp->old_name, MAX_PATH);
-        size_t name_len2 = strnlen_s(path_temp->new_object_name, MAX_PATH);
+        size_t path_len  = intern_get(path_temp->path)->len;
+        size_t name_len1 = intern_get(path_temp->old_name)->len;
+        size_t name_len2 = intern_get(path_temp->new_object_name)->len;
 
         if (name_len1 > max_name_len) {
             max_name_len = name_len1;
@@ -525,115 +970,76 @@ int main(int argc, char *argv[])
             max_path_len = path_len;
         }
     }
-    log_save(_log_file, "\n[object name max length] %d\n", max_name_len);
-    log_save(_log_file, "[object path max length] %d\n", max_path_len);
+    log_save(log, "\n[object name max length] %zu\n", max_name_len);
+    log_save(log, "[object path max length] %zu\n", max_path_len);
 
     /* 打印抓取的 object 名称和路径 */
-    log_save(_log_file, "\n[object in map file]\n");
-    for (struct object_info *object_temp = object_info_head;
+    log_save(log, "\n[object in map file]\n");
+    for (struct object_info *object_temp = object_info_list.head;
          object_temp != NULL;
          object_temp = object_temp->next)
     {
-        log_save(_log_file, "[object name] %s%*s [path] %s\n", 
-                 object_temp->name, max_name_len + 1 - strlen(object_temp->name), " ", object_temp->path);
+        log_save(log, "[object name] %s%*s [path] %s\n", 
+                 object_temp->name, (int)(max_name_len + 1 - strlen(object_temp->name)), " ", object_temp->path);
     }
 
     /* 打印抓取的 keil 工程中的文件名和路径 */
-    log_save(_log_file, "\n[file path in keil project]\n");
-    for (struct file_path_list *path_list = _file_path_list_head; 
+    log_save(log, "\n[file path in keil project]\n");
+    for (struct file_path_list *path_list = ctx.file_list.head; 
          path_list != NULL; 
          path_list = path_list->next)
     {
-        log_save(_log_file, "[old name] %s%*s [type] %d   [path] %s\n", 
-                 path_list->old_name, max_name_len + 1 - strlen(path_list->old_name), " ", 
+        log_save(log, "[old name] %s%*s [type] %d   [path] %s\n", 
+                 path_list->old_name, (int)(max_name_len + 1 - strlen(path_list->old_name)), " ", 
                  path_list->file_type, path_list->path);
 
-        if (strcmp(path_list->object_name, path_list->new_object_name)) {
-            log_save(_log_file, "[new name] %s\n", path_list->new_object_name);
+        if (path_list->object_name != path_list->new_object_name) {
+            log_save(log, "[new name] %s\n", path_list->new_object_name);
         }
     }
 
-    /* 10.2 打开记录文件，打开失败则新建 */
-    snprintf(file_path, file_path_size, "%s\\%s-record.txt", _current_dir, APP_NAME);
+    /* 10.2 按工程名和 target 名查找上次的记录，记录不存在或格式不符时视为没有记录 */
+    record_key_build(job->record_key, sizeof(job->record_key), keil_prj_full_name, p_target_name);
+    log_save(log, "\n[record key] %s\n", job->record_key);
 
-    bool is_has_record = true;
-    FILE *p_file = fopen(file_path, "r");
-    if (p_file == NULL)
-    {
-        p_file = fopen(file_path, "w+");
-        if (p_file == NULL)
-        {
-            log_print(_log_file, "\n[ERROR] can't create log file\n");
-            log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
-            result = -15;
-            goto __exit;
-        }
-        is_has_record = false;
-    }
-    fclose(p_file);
+    uint64_t record_hash = record_store_hash(job->record_store, job->record_key);
 
-    /* 10.3 若存在记录文件，则读取各个文件 flash 和 RAM 占用情况 */
-    bool is_has_object = false;
-    bool is_has_region = false;
-    if (is_has_record)
-    {
-        record_file_process(file_path, 
-                            &record_load_region_head, 
-                            &record_object_info_head, 
-                            &is_has_object,
-                            &is_has_region,
-                            true);  /* !uvprojx_file.is_custom_scatter */
+    res = record_store_find(job->record_store, job->record_key, &record);
+    if (res == -2) {
+        log_print(log, "[WARNING] record file is invalid or out of date, it will be rebuilt\n \n");
     }
 
+    bool is_has_record = (res == 0);
+    bool is_has_object = (is_has_record && (record.header->flags & RECORD_FLAG_OBJECT));
+
+    /* 10.3 若存在记录文件，则将上次的 object 信息和 execution region 绑定到匹配的新的 object 信息和 execution region 上 */
     if (is_has_record)
     {
-        /* 将旧的 object 信息绑定到匹配的新的 object 信息上 */
-        for (struct object_info *new_obj_info = object_info_head;
-             new_obj_info != NULL;
-             new_obj_info = new_obj_info->next)
+        if (object_info_bind_old(&object_info_list, &record) == false
+        ||  load_region_bind_old(&load_region_list, &record) == false)
         {
-            for (struct object_info *old_obj_info = record_object_info_head;
-                 old_obj_info != NULL;
-                 old_obj_info = old_obj_info->next)
-            {
-                if (strcasecmp(new_obj_info->name, old_obj_info->name) == 0) {
-                    new_obj_info->old_object = old_obj_info;
-                }
-            }
+            log_print(log, "\n[ERROR] Failed to allocate record index memory\n");
+            result = -25;
+            goto __exit;
         }
 
-        log_save(_log_file, "\n[record region info]\n");
-        /* 将旧的 execution region 绑定到匹配的新的 execution region 上 */
-        for (struct load_region *old_load_region = record_load_region_head; 
-             old_load_region != NULL; 
-             old_load_region = old_load_region->next)
+        log_save(log, "\n[record region info]\n");
+        for (uint32_t i = 0; i < record.header->load_region_qty; i++)
         {
-            log_save(_log_file, "[load region] %s\n", old_load_region->name);
-            for (struct exec_region *old_exec_region = old_load_region->exec_region; 
-                 old_exec_region != NULL; 
-                 old_exec_region = old_exec_region->next)
+            const struct record_load_region *old_load_region = &record.load_region[i];
+            log_save(log, "[load region] %s\n", record.string + old_load_region->name);
+
+            for (uint32_t j = 0; j < old_load_region->exec_region_qty; j++)
             {
-                for (struct load_region *new_load_region = load_region_head; 
-                     new_load_region != NULL; 
-                     new_load_region = new_load_region->next)
-                {
-                    for (struct exec_region *new_exec_region = new_load_region->exec_region; 
-                         new_exec_region != NULL; 
-                         new_exec_region = new_exec_region->next)
-                    {
-                        if (strcmp(new_exec_region->name, old_exec_region->name) == 0) {
-                            new_exec_region->old_exec_region = old_exec_region;
-                        }
-                    }
-                }
-                log_save(_log_file, "\t[execution region] %s, 0x%.8X, 0x%.8X, 0x%.8X [type] %d [ID] %d\n", 
-                         old_exec_region->name, old_exec_region->base_addr, old_exec_region->size, 
-                         old_exec_region->used_size, old_exec_region->memory_type, old_exec_region->memory_id);
+                const struct record_exec_region *old_exec_region = &record.exec_region[old_load_region->exec_region_index + j];
+                log_save(log, "\t[execution region] %s, 0x%.8X, 0x%.8X, 0x%.8X\n", 
+                         record.string + old_exec_region->name, old_exec_region->base_addr, 
+                         old_exec_region->size, old_exec_region->used_size);
             }
         }
     }
 
-    /* 10.4 打印并保存本次编译信息至记录文件 */
+    /* 10.4 打印本次各个文件的 flash 和 RAM 占用情况 */
     if (uvprojx_file.is_enable_lto == false)
     {
         if (_is_display_object) 
@@ -650,41 +1056,17 @@ int main(int argc, char *argv[])
             else {
                 len = max_name_len;
             }
-            object_print_process(object_info_head, len, is_has_object);
-        }
-
-        /* 保存本次编译信息至记录文件 */
-        p_file = fopen(file_path, "w+");
-        if (p_file == NULL)
-        {
-            log_print(_log_file, "\n[ERROR] can't create record file\n");
-            log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
-            result = -16;
-            goto __exit;
+            object_print_process(log, object_info_list.head, len, is_has_object);
         }
-
-        fputs("      Code (inc. data)   RO Data    RW Data    ZI Data      Debug   Object Name\n", p_file);
-
-        for (struct object_info *object_temp = object_info_head;
-             object_temp != NULL;
-             object_temp = object_temp->next)
-        {
-            snprintf(_line_text, sizeof(_line_text), 
-                     "%10d %10d %10d %10d %10d %10d   %s\n",
-                     object_temp->code, 0, object_temp->ro_data, object_temp->rw_data, object_temp->zi_data, 0, object_temp->name);
-            fputs(_line_text, p_file);
-        }
-        fputs(STR_OBJECT_TOTALS "\n\n", p_file);
-        fclose(p_file);
     }
     else {
-        log_print(_log_file, "[WARNING] Because LTO is enabled, information for each file cannot be displayed\n \n");
+        log_print(log, "[WARNING] Because LTO is enabled, information for each file cannot be displayed\n \n");
     }
     
     /* 11. 打印总 flash 和 RAM 占用情况，以进度条显示 */
     /* 11.1 算出 execution region name 的最大长度  */
     size_t max_region_name = 0;
-    for (struct load_region *l_region = load_region_head; 
+    for (struct load_region *l_region = load_region_list.head; 
          l_region != NULL; 
          l_region = l_region->next)
     {
@@ -704,45 +1086,45 @@ int main(int argc, char *argv[])
     if (uvprojx_file.is_has_pack == false)
     {
     #if defined(ENABLE_REFER_TO_KEIL_DIALOG) && (ENABLE_REFER_TO_KEIL_DIALOG != 0)
-        if (_memory_info_head == NULL) {
+        if (ctx.memory_list.head == NULL) {
             print_mode = MEMORY_PRINT_MODE_2;
         } else {
             print_mode = MEMORY_PRINT_MODE_1;
         }
     #else
-        if (_memory_info_head && uvprojx_file.is_custom_scatter == false) {
+        if (ctx.memory_list.head && uvprojx_file.is_custom_scatter == false) {
             print_mode = MEMORY_PRINT_MODE_1;
         } else {
             print_mode = MEMORY_PRINT_MODE_2;
         }
     #endif
     }
-    log_save(_log_file, "[memory print mode]: %d\n", print_mode);
+    log_save(log, "[memory print mode]: %d\n", print_mode);
 
     /* 11.3 开始打印 */
     bool is_print_null = true;
-    for (struct load_region *l_region = load_region_head; 
+    for (struct load_region *l_region = load_region_list.head; 
          l_region != NULL; 
          l_region = l_region->next)
     {
-        log_print(_log_file, "%s\n", l_region->name);
+        log_print(log, "%s\n", l_region->name);
         if (print_mode == MEMORY_PRINT_MODE_1)
         {
-            memory_mode1_print(l_region->exec_region, MEMORY_TYPE_RAM,     false, max_region_name, is_has_record);
-            memory_mode1_print(l_region->exec_region, MEMORY_TYPE_RAM,     true,  max_region_name, is_has_record);
-            memory_mode1_print(l_region->exec_region, MEMORY_TYPE_FLASH,   false, max_region_name, is_has_record);
-            memory_mode1_print(l_region->exec_region, MEMORY_TYPE_FLASH,   true,  max_region_name, is_has_record);
-            memory_mode1_print(l_region->exec_region, MEMORY_TYPE_UNKNOWN, false, max_region_name, is_has_record);
+            memory_mode1_print(log, l_region->exec_region, MEMORY_TYPE_RAM,     false, max_region_name, is_has_record);
+            memory_mode1_print(log, l_region->exec_region, MEMORY_TYPE_RAM,     true,  max_region_name, is_has_record);
+            memory_mode1_print(log, l_region->exec_region, MEMORY_TYPE_FLASH,   false, max_region_name, is_has_record);
+            memory_mode1_print(log, l_region->exec_region, MEMORY_TYPE_FLASH,   true,  max_region_name, is_has_record);
+            memory_mode1_print(log, l_region->exec_region, MEMORY_TYPE_UNKNOWN, false, max_region_name, is_has_record);
         }
         else if (print_mode == MEMORY_PRINT_MODE_2)
         {
-            memory_mode2_print(l_region->exec_region, max_region_name, is_has_record);
+            memory_mode2_print(log, l_region->exec_region, max_region_name, is_has_record);
         }
         else 
         {
-            memory_mode0_print(l_region->exec_region, MEMORY_TYPE_RAM,     max_region_name, is_has_record, is_print_null);
-            memory_mode0_print(l_region->exec_region, MEMORY_TYPE_FLASH,   max_region_name, is_has_record, is_print_null);
-            memory_mode0_print(l_region->exec_region, MEMORY_TYPE_UNKNOWN, max_region_name, is_has_record, is_print_null);
+            memory_mode0_print(log, &ctx.memory_list, l_region->exec_region, MEMORY_TYPE_RAM,     max_region_name, is_has_record, is_print_null);
+            memory_mode0_print(log, &ctx.memory_list, l_region->exec_region, MEMORY_TYPE_FLASH,   max_region_name, is_has_record, is_print_null);
+            memory_mode0_print(log, &ctx.memory_list, l_region->exec_region, MEMORY_TYPE_UNKNOWN, max_region_name, is_has_record, is_print_null);
         }
         is_print_null = false;
     }
@@ -753,81 +1135,216 @@ int main(int argc, char *argv[])
         res = combine_path(file_path, file_path_size, keil_prj_path, uvprojx_file.output_path);
         if (res == -1)
         {
-            log_print(_log_file, "\n[ERROR] %s not a absolute path\n \n", keil_prj_path);
+            log_print(log, "\n[ERROR] %s not a absolute path\n \n", keil_prj_path);
             result = -17;
             goto __exit;
         }
         else if (res == -2)
         {
-            log_print(_log_file, "\n[ERROR] relative paths go up more levels than absolute paths\n \n");
+            log_print(log, "\n[ERROR] relative paths go up more levels than absolute paths\n \n");
             result = -18;
             goto __exit;
         }
         snprintf(file_path, file_path_size, "%s%s.htm", file_path, uvprojx_file.output_name);
-        log_save(_log_file, "[htm file path] %s\n", file_path);
-        stack_print_process(file_path);
+        log_save(log, "[htm file path] %s\n", file_path);
+        cache_input_add(&ctx, &inputs, file_path, NULL);
+        stack_print_process(&ctx, file_path);
     }
 
-    /* 13. 保存本次 region 信息至记录文件 */
-    snprintf(file_path, file_path_size, "%s\\%s-record.txt", _current_dir, APP_NAME);
+    /* 13. 生成本次的记录，全部任务完成后统一写入记录文件 */
+    /* 未解析本次的 object 信息时，保留上次的记录 */
+    if (record_image_build(&job->record_image, 
+                           is_get_object ? &object_info_list : NULL, 
+                           &record, 
+                           &load_region_list) == false)
+    {
+        text_buffer_free(&job->record_image);
+        log_print(log, "\n[ERROR] Failed to allocate record file memory\n");
+        result = -15;
+        goto __exit;
+    }
 
-    if (uvprojx_file.is_enable_lto) {
-        p_file = fopen(file_path, "w+");
-    } else {
-        p_file = fopen(file_path, "a");
+    /* 本次没有解析 object 信息时，构建历史中不包含 object 信息 */
+    if (history_build_create(&job->history_build, 
+                             job->record_key, 
+                             (int64_t)time(NULL), 
+                             is_get_object ? &object_info_list : NULL, 
+                             &load_region_list) == false)
+    {
+        text_buffer_free(&job->history_build);
+        log_print(log, "\n[WARNING] Failed to allocate history memory, this build is not saved to history\n");
     }
-    if (p_file == NULL)
+
+    /* 14. 生成本次的分析缓存，输入文件未改变时下次直接重放 */
+    if (cache_image_build(job, &inputs, record_hash) == false)
     {
-        log_print(_log_file, "\n[ERROR] can't create record file\n");
-        log_print(_log_file, "[ERROR] Please check: %s\n", file_path);
-        result = -19;
-        goto __exit;
+        text_buffer_free(&job->cache_image);
+        log_save(log, "\n[WARNING] Failed to create cache, the next build is analyzed again\n");
     }
 
-    fputs(STR_MEMORY_MAP_OF_THE_IMAGE "\n\n", p_file);
+__exit:
+    if (file_path) {
+        free(file_path);
+    }
 
-    for (struct load_region *l_region = load_region_head; 
-         l_region != NULL; 
-         l_region = l_region->next)
+    QueryPerformanceCounter(&stop);
+    log_save(log, "\n[arena] used: %zu bytes, reserved: %zu bytes\n", ctx.arena.used, ctx.arena.reserved);
+    log_save(log, "[project time] %.3f s\n", (double)(stop.QuadPart - start.QuadPart) / freq.QuadPart);
+    parse_context_free(&ctx);
+    return result;
+}
+
+
+/**
+ * @brief  工程分析线程
+ * @note   按序号领取任务，直至全部任务被领取
+ * @param  param: 线程池
+ * @retval 0
+ */
+DWORD WINAPI project_worker(LPVOID param)
+{
+    struct project_pool *pool = (struct project_pool *)param;
+
+    while (1)
     {
-        snprintf(_line_text, sizeof(_line_text),
-                 "\t%s %s \n\n",
-                 STR_LOAD_REGION, l_region->name);
-        fputs(_line_text, p_file);
+        size_t index = (size_t)InterlockedIncrement(&pool->next) - 1;
+        if (index >= pool->job_qty) {
+            break;
+        }
+        pool->jobs[index].result = project_process(&pool->jobs[index]);
+    }
 
-        for (struct exec_region *e_region = l_region->exec_region; 
-             e_region != NULL; 
-             e_region = e_region->next)
+    return 0;
+}
+
+
+/**
+ * @brief  使用线程池分析全部工程
+ * @note   线程数不超过任务数及 MAXIMUM_WAIT_OBJECTS。线程创建失败时由当前线程完成剩余任务
+ * @param  jobs:        工程分析任务列表
+ * @param  job_qty:     任务数量
+ * @param  worker_qty:  线程数量
+ * @retval None
+ */
+void project_pool_run(struct project_job *jobs, 
+                      size_t job_qty, 
+                      size_t worker_qty)
+{
+    struct project_pool pool = {
+        .jobs    = jobs,
+        .job_qty = job_qty,
+        .next    = 0,
+    };
+
+    if (worker_qty > job_qty) {
+        worker_qty = job_qty;
+    }
+    if (worker_qty > MAXIMUM_WAIT_OBJECTS) {
+        worker_qty = MAXIMUM_WAIT_OBJECTS;
+    }
+
+    HANDLE threads[MAXIMUM_WAIT_OBJECTS];
+    DWORD thread_qty = 0;
+
+    /* 当前线程也参与分析，只需另外创建 worker_qty - 1 个线程 */
+    if (worker_qty > 1)
+    {
+        for (size_t i = 0; i < worker_qty - 1; i++)
         {
-            snprintf(_line_text, sizeof(_line_text),
-                     "\t\t%s %s (%s0x%.8X, %s0x%.8X, %s0x%.8X, END)\n\n",
-                     STR_EXECUTION_REGION, e_region->name, STR_EXECUTE_BASE_ADDR, e_region->base_addr,
-                     STR_REGION_USED_SIZE, e_region->used_size, STR_REGION_MAX_SIZE, e_region->size);
-            fputs(_line_text, p_file);
+            threads[thread_qty] = CreateThread(NULL, 0, project_worker, &pool, 0, NULL);
+            if (threads[thread_qty] == NULL) {
+                break;
+            }
+            thread_qty++;
         }
     }
-    fputs(STR_IMAGE_COMPONENT_SIZE, p_file);
-    fclose(p_file);
-    
-__exit:
-    if (_current_dir) {
-        free(_current_dir);
+
+    project_worker(&pool);
+
+    if (thread_qty)
+    {
+        WaitForMultipleObjects(thread_qty, threads, TRUE, INFINITE);
+        for (DWORD i = 0; i < thread_qty; i++) {
+            CloseHandle(threads[i]);
+        }
     }
-    if (file_path) {
-        free(file_path);
+}
+
+
+/**
+ * @brief  将工程分析任务展开为各 target 的分析任务
+ * @note   每个 uvprojx 文件只映射并扫描一次，展开后的任务指向各自 target 在映射中的区间。
+ *         无法打开或未找到 target 的工程保留原任务，由 project_process 报告错误
+ * @param  jobs:        [in/out] 工程分析任务列表，展开后替换为新的列表
+ * @param  job_qty:     [in/out] 任务数量
+ * @param  mappings:    [out] 各工程 uvprojx 文件的映射，数量与展开前的任务数量相同
+ * @retval 0: 正常 | -x: 错误
+ */
+int project_target_expand(struct project_job **jobs, 
+                          size_t *job_qty, 
+                          struct file_mapping *mappings)
+{
+    char file_path[MAX_PATH * 2] = {0};
+    size_t target_qty = 0;
+
+    struct text_range **ranges = (struct text_range **)calloc(*job_qty, sizeof(struct text_range *));
+    size_t *range_qty          = (size_t *)calloc(*job_qty, sizeof(size_t));
+    if (ranges == NULL || range_qty == NULL)
+    {
+        free(ranges);
+        free(range_qty);
+        return -1;
     }
-    object_info_free(&object_info_head);
-    object_info_free(&record_object_info_head);
-    load_region_free(&load_region_head);
-    load_region_free(&record_load_region_head);
 
-    file_path_free(&_file_path_list_head);
-    memory_info_free(&_memory_info_head);
-    prj_path_list_free(_keil_prj_path_list);
-    log_print(_log_file, "=============================================================================================================================\n\n");
-    log_save(_log_file, "run time: %.3f s\n", (double)(clock() - run_time) / CLOCKS_PER_SEC);
-    fclose(_log_file);
-    return result;
+    for (size_t i = 0; i < *job_qty; i++)
+    {
+        snprintf(file_path, sizeof(file_path), "%s\\%s", _current_dir, (*jobs)[i].prj_name);
+        if (file_mapping_open(&mappings[i], file_path)) {
+            range_qty[i] = uvprojx_target_index_build(mappings[i].data, mappings[i].size, &ranges[i]);
+        }
+        target_qty += (range_qty[i] > 0) ? range_qty[i] : 1;
+    }
+
+    struct project_job *target_jobs = (struct project_job *)calloc(target_qty, sizeof(struct project_job));
+    if (target_jobs)
+    {
+        size_t seq = 0;
+        for (size_t i = 0; i < *job_qty; i++)
+        {
+            if (range_qty[i] == 0) 
+            {
+                target_jobs[seq++] = (*jobs)[i];
+                continue;
+            }
+
+            for (size_t j = 0; j < range_qty[i]; j++)
+            {
+                struct project_job *target_job = &target_jobs[seq++];
+
+                *target_job = (*jobs)[i];
+                target_job->target_range    = ranges[i][j];
+                target_job->target_index    = j + 1;
+                target_job->is_batch        = true;
+                target_job->log.is_buffered = true;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < *job_qty; i++) {
+        free(ranges[i]);
+    }
+    free(ranges);
+    free(range_qty);
+
+    if (target_jobs == NULL) {
+        return -1;
+    }
+
+    free(*jobs);
+    *jobs    = target_jobs;
+    *job_qty = target_qty;
+
+    return 0;
 }
 
 
@@ -853,7 +1370,7 @@ int parameter_process(int    param_qty,
 {
     for (size_t i = 1; i < param_qty; i++)
     {
-        log_save(_log_file, "[param %d] %s\n", i, param[i]);
+        log_save(&_log_file, "[param %zu] %s\n", i, param[i]);
 
         if (param[i][0] == '-') 
         {
@@ -879,6 +1396,61 @@ int parameter_process(int    param_qty,
             else if (strcasecmp(param[i], _command_list[seq++].cmd) == 0) {
                 _progress_style = PROGRESS_STYLE_2;
             }
+            else if (strcasecmp(param[i], _command_list[seq++].cmd) == 0) {
+                _is_all_project = true;
+            }
+            else if (strcasecmp(param[i], _command_list[seq++].cmd) == 0) {
+                _is_all_target = true;
+            }
+            else if (strncasecmp(param[i], _command_list[seq++].cmd, strlen("-JOBS=")) == 0)
+            {
+                char *end_ptr = NULL;
+                _worker_qty = strtoul(&param[i][strlen("-JOBS=")], &end_ptr, 10);
+                if (*end_ptr != '\0' || _worker_qty == 0) 
+                {
+                    *err_param = i;
+                    return -3;
+                }
+            }
+            else if (strncasecmp(param[i], _command_list[seq++].cmd, strlen("-HOBJ=")) == 0)
+            {
+                const char *name = &param[i][strlen("-HOBJ=")];
+                strncpy_s(_history_object, sizeof(_history_object), name, strnlen_s(name, sizeof(_history_object)));
+            }
+            else if (strncasecmp(param[i], _command_list[seq++].cmd, strlen("-HLAST=")) == 0)
+            {
+                char *end_ptr = NULL;
+                _history_build_qty = strtoul(&param[i][strlen("-HLAST=")], &end_ptr, 10);
+                if (*end_ptr != '\0' || _history_build_qty == 0) 
+                {
+                    *err_param = i;
+                    return -3;
+                }
+            }
+            else if (strncasecmp(param[i], _command_list[seq++].cmd, strlen("-HREGION=")) == 0)
+            {
+                char *name  = &param[i][strlen("-HREGION=")];
+                char *colon = strrchr(name, ':');
+                char *end_ptr = NULL;
+                if (colon == NULL || colon == name) 
+                {
+                    *err_param = i;
+                    return -3;
+                }
+                _history_percent = strtod(colon + 1, &end_ptr);
+                if (*end_ptr != '\0' || end_ptr == colon + 1) 
+                {
+                    *err_param = i;
+                    return -3;
+                }
+                *colon = '\0';
+                strncpy_s(_history_region, sizeof(_history_region), name, strnlen_s(name, sizeof(_history_region)));
+            }
+#if defined(ENABLE_BENCHMARK) && (ENABLE_BENCHMARK != 0)
+            else if (strcasecmp(param[i], _command_list[seq++].cmd) == 0) {
+                _is_benchmark = true;
+            }
+#endif
             else if (strcasecmp(param[i], "-H")    == 0
             ||       strcasecmp(param[i], "-HELP") == 0) {
                 return -4;
@@ -973,47 +1545,52 @@ int parameter_process(int    param_qty,
 /**
  * @brief  uvoptx 文件处理
  * @note   获取指定的 target name
+ * @param  ctx:         解析上下文
  * @param  file_path:   uvoptx 文件路径
  * @param  target_name: [out] keil target name
  * @param  max_size:    target_name 的最大 size
- * @retval true: 成功 | false: 失败
+ * @retval 0: 成功 | -1: 无法打开 | -2: target name 超出 max_size
  */
-bool uvoptx_file_process(const char *file_path, 
-                         char *target_name,
-                         size_t max_size)
+int uvoptx_file_process(struct parse_context *ctx,
+                        const char *file_path, 
+                        char *target_name,
+                        size_t max_size)
 {
-    FILE *p_file = fopen(file_path, "r");
-    if (p_file == NULL) {
-        return false;
+    struct file_mapping mapping;
+    if (file_mapping_open(&mapping, file_path) == false) {
+        return -1;
     }
 
+    struct text_range range = {
+        .start = mapping.data,
+        .end   = mapping.data + mapping.size,
+    };
+    struct xml_reader reader;
+    struct xml_event event;
+    xml_reader_init(&reader, &range);
+
     uint8_t state = 0;
-    while (fgets(_line_text, sizeof(_line_text), p_file))     
+    bool is_complete = true;
+    while (state != 2 && xml_reader_next(&reader, &event))     
     { 
-        char *str;
+        if (event.type != XML_EVENT_END) {
+            continue;
+        }
+
         switch (state)
         {
             case 0:
-                str = strstr(_line_text, LABEL_TARGET_NAME);
-                if (str)
+                if (xml_name_is(&event, LABEL_TARGET_NAME))
                 {
-                    str += strlen(LABEL_TARGET_NAME);
-                    char *lt = strrchr(_line_text, '<');
-                    if (lt) 
-                    {
-                        *lt = '\0';
-                        strncpy_s(target_name, max_size, str, strnlen_s(str, max_size));
-                        log_save(_log_file, "[target name] %s\n", target_name);
-                        state = 1;
-                    }
+                    is_complete = xml_text_copy(&event, target_name, max_size);
+                    log_save(ctx->log, "[target name] %s\n", target_name);
+                    state = 1;
                 }
                 break;
             case 1:
-                str = strstr(_line_text, LABEL_IS_CURRENT_TARGET);
-                if (str)
+                if (xml_name_is(&event, LABEL_IS_CURRENT_TARGET))
                 {
-                    str += strlen(LABEL_IS_CURRENT_TARGET);
-                    if (*str == '0') {
+                    if (xml_text_is_zero(&event)) {
                         state = 0;
                     } else {
                         state = 2;
@@ -1022,85 +1599,125 @@ bool uvoptx_file_process(const char *file_path,
                 break;
             default: break;
         }
-        if (state == 2) 
-        {
-            log_save(_log_file, "[final target name] %s\n", target_name);
-            break;
-        }
     }
-    fclose(p_file);
+    if (state == 2) {
+        log_save(ctx->log, "[final target name] %s\n", target_name);
+    }
+    file_mapping_close(&mapping);
 
-    return true;
+    /* 截断的 target name 无法与 uvprojx 中的 target 匹配 */
+    return (state == 2 && is_complete == false) ? -2 : 0;
 }
 
 
 /**
  * @brief  uvprojx 文件处理
  * @note   获取 uvprojx 文件中的信息
+ * @param  ctx:                 解析上下文
  * @param  file_path:           uvprojx 文件的绝对路径
- * @param  target_name:         指定的 target name
+ * @param  target_name:         指定的 target name，is_get_target_name 为 true 时忽略
  * @param  out_info:            [out] 解析出的 uvprojx 信息
- * @param  is_get_target_name:  是否获取 target name
+ * @param  is_get_target_name:  是否获取 target name，为 true 时选择第一个 target
  * @retval 0: 成功 | -x: 失败
  */
-int uvprojx_file_process(const char *file_path, 
+int uvprojx_file_process(struct parse_context *ctx,
+                         const char *file_path, 
                          const char *target_name,
                          struct uvprojx_info *out_info,
                          bool is_get_target_name)
 {
     /* 打开同名的 .uvprojx 或 .uvproj 文件 */
-    FILE *p_file = fopen(file_path, "r");
-    if (p_file == NULL) {
+    struct file_mapping mapping;
+    if (file_mapping_open(&mapping, file_path) == false) {
         return -1;
     }
 
-    char *str     = NULL;
-    char *lt      = NULL;
+    struct text_range range = {
+        .start = mapping.data,
+        .end   = mapping.data + mapping.size,
+    };
+    int result = uvprojx_target_process(ctx, &range, target_name, out_info, is_get_target_name);
+    file_mapping_close(&mapping);
+
+    return result;
+}
+
+
+/**
+ * @brief  uvprojx target 处理
+ * @note   从 uvprojx 文件的文本区间中获取指定 target 的信息，区间内的内容只读取一次
+ * @param  ctx:                 解析上下文
+ * @param  target_range:        uvprojx 文件或其中单个 target 的文本区间
+ * @param  target_name:         指定的 target name，is_get_target_name 为 true 时忽略
+ * @param  out_info:            [out] 解析出的 uvprojx 信息
+ * @param  is_get_target_name:  是否获取 target name，为 true 时选择区间内的第一个 target
+ * @retval 0: 成功 | -x: 失败
+ */
+int uvprojx_target_process(struct parse_context *ctx,
+                           const struct text_range *target_range,
+                           const char *target_name,
+                           struct uvprojx_info *out_info,
+                           bool is_get_target_name)
+{
+    struct xml_reader reader;
+    struct xml_event event;
+    xml_reader_init(&reader, target_range);
+
+    int result    = 0;
     uint8_t state = 0;
-    long mem_pos  = 0;
+    bool is_add_memory_area = false;
+    bool is_complete        = true;
 
-    /* 逐行读取 */
-    while (fgets(_line_text, sizeof(_line_text), p_file))     
+    while (state != 11 && xml_reader_next(&reader, &event))     
     { 
+        /* memory area 及工程文件按元素的嵌套解析，其余的选项只需叶子元素的内容 */
+        if (state == 8 || state == 9) {
+            memory_area_process(ctx, &event);
+        }
+        if (state == 10)
+        {
+            /* 获取已加入编译的文件路径，并记录重复的文件名 */
+            if (file_path_process(ctx, &event, &out_info->is_has_user_lib) == false) {
+                state = 11;
+            }
+            continue;
+        }
+        if (event.type != XML_EVENT_END) {
+            continue;
+        }
+
         switch (state)
         {
             case 0:
-                str = strstr(_line_text, target_name);
-                if (str) 
+                if (xml_name_is(&event, LABEL_TARGET_NAME))
                 {
-                    if (is_get_target_name)
+                    if (is_get_target_name) 
                     {
-                        str += strlen(LABEL_TARGET_NAME);
-                        lt   = strrchr(_line_text, '<');
-                        if (lt) 
-                        {
-                            *lt = '\0';
-                            strncpy_s(out_info->target_name, sizeof(out_info->target_name), str, strnlen_s(str, sizeof(out_info->target_name)));
-                        }
+                        is_complete = xml_text_copy(&event, out_info->target_name, sizeof(out_info->target_name));
+                        state = 1;
+                    }
+                    else if ((size_t)(event.text.end - event.text.start) == strlen(target_name)
+                         &&  memcmp(event.text.start, target_name, strlen(target_name)) == 0) 
+                    {
+                        state = 1;
                     }
-                    state = 1;
                 }
                 break;
             case 1:
-                str = strstr(_line_text, LABEL_DEVICE);
-                if (str)
+                if (xml_name_is(&event, LABEL_DEVICE))
                 {
-                    str += strlen(LABEL_DEVICE);
-                    lt   = strrchr(_line_text, '<');
-                    if (lt) 
-                    {
-                        *lt = '\0';
-                        strncpy_s(out_info->chip, sizeof(out_info->chip), str, strnlen_s(str, sizeof(out_info->chip)));
-                        state = 2;
+                    /* chip 仅用于显示，截断时继续 */
+                    if (xml_text_copy(&event, out_info->chip, sizeof(out_info->chip)) == false) {
+                        log_save(ctx->log, "[WARNING] device name is longer than %d characters: %s\n", MAX_PRJ_NAME_SIZE - 1, out_info->chip);
                     }
+                    state = 2;
                 }
                 break;
             case 2:
-                str = strstr(_line_text, LABEL_VENDOR);
-                if (str)
+                if (xml_name_is(&event, LABEL_VENDOR))
                 {
-                    str += strlen(LABEL_VENDOR);
-                    if (strncasecmp(str, "ARM", 3) == 0) 
+                    if ((size_t)(event.text.end - event.text.start) >= 3
+                    &&  strncasecmp(event.text.start, "ARM", 3) == 0) 
                     {
                         out_info->is_has_pack = false;
                         state = 4;
@@ -1113,442 +1730,537 @@ int uvprojx_file_process(const char *file_path,
                 }
                 break;
             case 3:
-                bool is_get_first    = false;
-                char *str_p1         = NULL;
-                char *str_p2         = NULL;
-                char *end_ptr        = NULL;
-                char name[MAX_PRJ_NAME_SIZE] = {0};
-                uint32_t base_addr   = 0;
-                uint32_t size        = 0;
-                size_t mem_id        = UNKNOWN_MEMORY_ID;
-                MEMORY_TYPE mem_type = MEMORY_TYPE_NONE;
-
                 /* 获取 RAM 和 ROM  */
-                str = strstr(_line_text, LABEL_CPU);
-                if (str)
+                if (xml_name_is(&event, LABEL_CPU))
                 {
-                    strtok(_line_text, " ");
-                    while (1)
+                    if (cpu_memory_process(ctx, &event) == false) 
                     {
-                        if (is_get_first == false) 
-                        {
-                            str_p1  = strstr(_line_text, LABEL_CPU);
-                            str_p1 += strlen(LABEL_CPU);
-                            is_get_first = true;
-                        }
-                        else 
-                        {
-                            str_p1 = strtok(NULL, " ");
-                            if (str_p1 == NULL)
-                            {
-                                state = 3;
-                                break;
-                            }
-                        }
-
-                        str_p2  = strstr(str_p1, "(");
-                        *str_p2 = '\0';
-                        strncpy_s(name, sizeof(name), str_p1, strnlen_s(str_p1, sizeof(name)));
-
-                        mem_type = MEMORY_TYPE_UNKNOWN;
-                        if (strstr(name, "RAM")) {
-                            mem_type = MEMORY_TYPE_RAM;
-                        } 
-                        else if (strstr(name, "ROM")) {
-                            mem_type = MEMORY_TYPE_FLASH;
-                        }
-                        else 
-                        {
-                            state = 4;
-                            break;
-                        }
-
-                        str_p1  = str_p2 + 1;
-                        str_p2 += 3;
-                        while ((*str_p2 >= '0') && (*str_p2 <= 'F')) {
-                            str_p2 += 1;
-                        } 
-
-                        uint8_t parse_mode = 0;
-                        if (*str_p2 == ',') {
-                            parse_mode = 0;
-                        } 
-                        else if (*str_p2 == '-') {
-                            parse_mode = 1;
-                        } 
-                        else {
-                            return -2;
-                        }
-
-                        *str_p2   = '\0';
-                        base_addr = strtoul(str_p1, &end_ptr, 16); 
-
-                        str_p1    = str_p2 + 1;
-                        str_p2    = strstr(str_p1, ")");
-                        *str_p2   = '\0';
-                        size      = strtoul(str_p1, &end_ptr, 16);
-
-                        if (parse_mode == 1) 
-                        {
-                            size -= base_addr;
-                            size += 1;
-                        }
-
-                        if (mem_type == MEMORY_TYPE_UNKNOWN) {
-                            memory_info_add(&_memory_info_head, name, 1, base_addr, size, mem_type, true, true);
-                        } 
-                        else 
-                        {
-                            mem_id++;
-                            memory_info_add(&_memory_info_head, name, mem_id, base_addr, size, mem_type, false, true);
-                        }
+                        result = -2;
+                        state  = 11;
+                    }
+                    else {
+                        state = 4;
                     }
                 }
                 break;
             case 4:
-                str = strstr(_line_text, LABEL_OUTPUT_DIRECTORY);
-                if (str)
+                if (xml_name_is(&event, LABEL_OUTPUT_DIRECTORY))
                 {
-                    str += strlen(LABEL_OUTPUT_DIRECTORY);
-                    lt   = strrchr(_line_text, '<');
-                    if (lt) 
-                    {
-                        *lt = '\0';
-                        strncpy_s(out_info->output_path, sizeof(out_info->output_path), str, strnlen_s(str, sizeof(out_info->output_path)));
-                        state = 5;
-                    }
+                    is_complete &= xml_text_copy(&event, out_info->output_path, sizeof(out_info->output_path));
+                    state = 5;
                 }
                 break;
             case 5:
-                str = strstr(_line_text, LABEL_OUTPUT_NAME);
-                if (str)
+                if (xml_name_is(&event, LABEL_OUTPUT_NAME))
                 {
-                    str += strlen(LABEL_OUTPUT_NAME);
-                    lt   = strrchr(_line_text, '<');
-                    if (lt) 
-                    {
-                        *lt = '\0';
-                        strncpy_s(out_info->output_name, sizeof(out_info->output_name), str, strnlen_s(str, sizeof(out_info->output_name)));
-                        state = 6;
-                    }
+                    is_complete &= xml_text_copy(&event, out_info->output_name, sizeof(out_info->output_name));
+                    state = 6;
                 }
                 break;
             case 6:
-                str = strstr(_line_text, LABEL_LISTING_PATH);
-                if (str)
+                if (xml_name_is(&event, LABEL_LISTING_PATH))
                 {
-                    str += strlen(LABEL_LISTING_PATH);
-                    lt   = strrchr(_line_text, '<');
-                    if (lt) 
+                    is_complete &= xml_text_copy(&event, out_info->listing_path, sizeof(out_info->listing_path));
+                    state = 7;
+                    if (is_complete == false) 
                     {
-                        *lt = '\0';
-                        strncpy_s(out_info->listing_path, sizeof(out_info->listing_path), str, strnlen_s(str, sizeof(out_info->listing_path)));
-                        state = 7;
+                        /* 截断的名称及路径无法定位 map 文件，也不能作为记录的 key */
+                        result = -4;
+                        state  = 11;
                     }
                 }
                 break;
             case 7:
                 /* 检查是否生成了 map 文件 */
-                str = strstr(_line_text, LABEL_IS_CREATE_MAP);
-                if (str)
+                if (xml_name_is(&event, LABEL_IS_CREATE_MAP))
                 {
-                    str += strlen(LABEL_IS_CREATE_MAP);
-                    if (*str == '0') {
-                        return -3;
+                    if (xml_text_is_zero(&event)) 
+                    {
+                        result = -3;
+                        state  = 11;
                     } 
                     else 
                     {
                         /* 没有 pack 就读取自定义的 memory area */
-                        if (out_info->is_has_pack == false || _memory_info_head == NULL) {
-                            state = 8;
-                        } else {
-                            state = 9;
-                        }
-                        mem_pos = ftell(p_file);
+                        is_add_memory_area = (out_info->is_has_pack == false || ctx->memory_list.head == NULL);
+                        state = 8;
                     }
                 }
                 break;
             case 8:
-                /* 读取自定义 memory area */
-                if (memory_area_process(_line_text, false) == false) {
-                    state = 9;
-                }
-                break;
-            case 9:
-                /* 检查是否开启了 LTO */
-                if (({str = strstr(_line_text, LABEL_AC6_LTO); str;}))
+                /* 检查是否开启了 LTO，memory area 在此之前已读取 */
+                if (xml_name_is(&event, LABEL_AC6_LTO))
                 {
-                    str += strlen(LABEL_AC6_LTO);
-                    if (*str == '0') {
-                        out_info->is_enable_lto = false;
-                    } else {
-                        out_info->is_enable_lto = true;
-                    }
-                    state = 10;
+                    out_info->is_enable_lto = !xml_text_is_zero(&event);
+                    state = 9;
                 }
-                else if (({str = strstr(_line_text, LABEL_END_CADS); str;}))
+                else if (xml_name_is(&event, LABEL_CADS))
                 {
                     out_info->is_enable_lto = false;
-                    state = 10;
+                    state = 9;
+                }
+                if (state == 9 && is_add_memory_area) {
+                    memory_area_add(ctx, false);
                 }
                 break;
-            case 10:
-                /* 读取是否使用了 keil 生成的 scatter file */
-                str = strstr(_line_text, LABEL_IS_KEIL_SCATTER);
-                if (str)
+            case 9:
+                /* 读取是否使用了 keil 生成的 scatter file，是则将新的 memory area 加入 memory info 中 */
+                if (xml_name_is(&event, LABEL_IS_KEIL_SCATTER))
                 {
-                    str += strlen(LABEL_IS_KEIL_SCATTER);
-                    if (*str == '0') 
-                    {
-                        out_info->is_custom_scatter = true;
-                        fseek(p_file, mem_pos, SEEK_SET);
-                        state = 11;
+                    out_info->is_custom_scatter = xml_text_is_zero(&event);
+                    if (out_info->is_custom_scatter) {
+                        memory_area_add(ctx, true);
                     }
-                    else 
-                    {
-                        out_info->is_custom_scatter = false;
-                        state = 12;
-                    }
-                }
-                else if (strstr(_line_text, LABEL_END_LDADS)) {
-                    state = 12;
-                }
-                break;
-            case 11:
-                /* 将新的 memory area 加入 memory info 中 */
-                if (memory_area_process(_line_text, true) == false) {
-                    state = 12;
+                    state = 10;
                 }
-                break;
-            case 12:
-                /* 获取已加入编译的文件路径，并记录重复的文件名 */
-                if (file_path_process(_line_text, &out_info->is_has_user_lib) == false) {
-                    state = 13;
+                else if (xml_name_is(&event, LABEL_LDADS)) {
+                    state = 10;
                 }
                 break;
             default: break;
         }
-        if (state == 13) {
-            break;
-        }
     }
-    fclose(p_file);
 
-    return true;
+    return result;
 }
 
 
 /**
- * @brief  读取 build_log 文件，获取文件的改名信息
- * @note   
- * @param  file_path: build_log 文件所在的路径
- * @retval 
+ * @brief  <Cpu> 中的 RAM 和 ROM 处理
+ * @note   如 IRAM(0x20000000,0x00010000) IROM(0x08000000-0x0807FFFF) CPUTYPE("Cortex-M3")，
+ *         遇到非 RAM 和 ROM 的项时结束。内存不足时记录警告后忽略，不作为格式错误
+ * @param  ctx:   解析上下文
+ * @param  event: <Cpu> 的 END 事件
+ * @retval true: 成功 | false: 含有不支持的格式
  */
-void build_log_file_process(const char *file_path)
+bool cpu_memory_process(struct parse_context *ctx, const struct xml_event *event)
 {
-    FILE *p_file = fopen(file_path, "r");
-    if (p_file == NULL) {
-        return;
+    struct text_buffer *line = &ctx->line;
+    size_t len = event->text.end - event->text.start;
+
+    line->size = 0;
+    if (text_buffer_append(line, event->text.start, len) == false) 
+    {
+        log_save(ctx->log, "[WARNING] Failed to allocate <Cpu> memory, the IRAM/IROM memories are ignored\n");
+        return true;
     }
 
-    char *ptr = NULL;
-    log_save(_log_file, "\n");
+    char *context = NULL;
+    char *str_p1  = strtok_s(line->data, " ", &context);
+    char *str_p2  = NULL;
+    char *end_ptr = NULL;
+    char *name    = NULL;
+    size_t mem_id = UNKNOWN_MEMORY_ID;
 
-    while (fgets(_line_text, sizeof(_line_text), p_file))
+    for (; str_p1 != NULL; str_p1 = strtok_s(NULL, " ", &context))
     {
-        if (({ptr = strstr(_line_text, STR_RENAME_MARK); ptr;}))
-        {
-            log_save(_log_file, "%s", _line_text);
+        str_p2 = strstr(str_p1, "(");
+        if (str_p2 == NULL) {
+            break;
+        }
+        *str_p2 = '\0';
+        name    = str_p1;
+
+        MEMORY_TYPE mem_type = MEMORY_TYPE_UNKNOWN;
+        if (strstr(name, "RAM")) {
+            mem_type = MEMORY_TYPE_RAM;
+        } 
+        else if (strstr(name, "ROM")) {
+            mem_type = MEMORY_TYPE_FLASH;
+        }
+        else {
+            break;
+        }
 
-            char *str_p1 = strstr(_line_text, "'");
-            str_p1 += 1;
-            char *str_p2 = strstr(str_p1, "'");
-            *str_p2 = '\0';
+        str_p1  = str_p2 + 1;
+        str_p2 += 3;
+        while ((*str_p2 >= '0') && (*str_p2 <= 'F')) {
+            str_p2 += 1;
+        } 
+
+        uint8_t parse_mode = 0;
+        if (*str_p2 == ',') {
+            parse_mode = 0;
+        } 
+        else if (*str_p2 == '-') {
+            parse_mode = 1;
+        } 
+        else {
+            return false;
+        }
 
-            for (struct file_path_list *path_temp = _file_path_list_head;
-                 path_temp != NULL;
-                 path_temp = path_temp->next)
-            {
-                if (strcmp(str_p1, path_temp->path) == 0)
-                {
-                    char *str_p3 = strrchr(str_p2 + 1, '\'');
-                    *str_p3 = '\0';
-                    str_p1  = strrchr(str_p2 + 1, '\\');
-                    str_p1 += 1;
-                    if (path_temp->new_object_name) {
-                        free(path_temp->new_object_name);
-                    }
-                    path_temp->new_object_name = strdup(str_p1);
-                    path_temp->is_rename       = false;
-                    log_save(_log_file, "'%s' rename to '%s'\n", path_temp->old_name, str_p1);
-                }
-            }
+        *str_p2 = '\0';
+        uint32_t base_addr = strtoul(str_p1, &end_ptr, 16); 
+
+        str_p1 = str_p2 + 1;
+        str_p2 = strstr(str_p1, ")");
+        if (str_p2) {
+            *str_p2 = '\0';
         }
-        else if (({ptr = strstr(_line_text, STR_COMPILING); ptr;})) {
-            break;
+        uint32_t size = strtoul(str_p1, &end_ptr, 16);
+
+        if (parse_mode == 1) 
+        {
+            size -= base_addr;
+            size += 1;
         }
+
+        mem_id++;
+        memory_info_add(&ctx->arena, &ctx->memory_list, name, mem_id, base_addr, size, mem_type, false, true);
     }
-    log_save(_log_file, "\n");
-    fclose(p_file);
-    return;
+
+    return true;
 }
 
 
 /**
- * @brief  文件名重名修改处理
- * @note   
- * @retval None
+ * @brief  建立 uvprojx 文件的 target 索引
+ * @note   只扫描一次文件内容。每个 target 的区间为 <Target> 元素的全部内容
+ * @param  data:     uvprojx 文件内容
+ * @param  size:     uvprojx 文件大小
+ * @param  targets:  [out] 各 target 的文本区间，由调用者释放
+ * @retval target 的数量，内存不足时为 0
  */
-void file_rename_process(void)
+size_t uvprojx_target_index_build(const char *data, 
+                                  size_t size, 
+                                  struct text_range **targets)
 {
-    char str[MAX_PRJ_NAME_SIZE] = {0};
+    size_t qty      = 0;
+    size_t capacity = 0;
+    struct text_range range = {data, data + size};
+    struct xml_reader reader;
+    struct xml_event event;
 
-    for (struct file_path_list *path_temp1 = _file_path_list_head;
-         path_temp1 != NULL;
-         path_temp1 = path_temp1->next)
+    *targets = NULL;
+    xml_reader_init(&reader, &range);
+
+    while (xml_reader_next(&reader, &event))
     {
-        size_t repeat = 0;
+        if ((event.type != XML_EVENT_START && event.type != XML_EVENT_END)
+        ||  xml_name_is(&event, LABEL_TARGET) == false)
+        {
+            continue;
+        }
 
-        for (struct file_path_list *path_temp2 = path_temp1->next;
-             path_temp2 != NULL;
-             path_temp2 = path_temp2->next)
+        if (event.type == XML_EVENT_END)
         {
-            if (path_temp2->is_rename
-            &&  strcmp(path_temp1->object_name, path_temp2->object_name) == 0)
-            {
-                repeat++;
+            if (qty > 0) {
+                (*targets)[qty - 1].end = reader.range.start;
+            }
+            continue;
+        }
 
-                strncpy_s(str, sizeof(str), path_temp2->old_name, strnlen_s(path_temp2->old_name, sizeof(str)));
-                char *dot = strrchr(str, '.');
-                if (dot) {
-                    *dot = '\0';
-                }
-                snprintf(str, sizeof(str), "%s_%d.o", str, repeat);
-                if (path_temp2->new_object_name) {
-                    free(path_temp2->new_object_name);
-                }
-                path_temp2->new_object_name = strdup(str);
-                path_temp2->is_rename       = false;
-                log_save(_log_file, "object '%s' rename to '%s'\n", path_temp2->old_name, str);
+        if (qty == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 4;
+            struct text_range *temp = (struct text_range *)realloc(*targets, capacity * sizeof(struct text_range));
+            if (temp == NULL)
+            {
+                free(*targets);
+                *targets = NULL;
+                return 0;
             }
+            *targets = temp;
         }
+
+        (*targets)[qty].start = event.start;
+        (*targets)[qty].end   = range.end;
+        qty++;
     }
+
+    return qty;
 }
 
 
 /**
- * @brief  自定义 memory area 读取
- * @note   
- * @param  str:     读取到的 uvprojx 文件的每一行文本
- * @param  is_new:  是否为新增的 memory area
- * @retval true: 继续 | false: 结束
+ * @brief  读取 build_log 文件，获取文件的改名信息
+ * @note   改名信息均位于第一个 compiling 行之前，先确定该区间，再在区间内直接查找改名行，不逐行读取。
+ *         文件路径统一分隔符后忽略大小写建立索引，每个改名行只查找一次
+ * @param  ctx:       解析上下文
+ * @param  file_path: build_log 文件所在的路径
+ * @retval None
+ */
+void build_log_file_process(struct parse_context *ctx, const char *file_path)
+{
+    struct file_mapping mapping;
+    if (file_mapping_open(&mapping, file_path) == false) {
+        return;
+    }
+
+    struct text_range range = {
+        .start = mapping.data,
+        .end   = mapping.data + mapping.size,
+    };
+    range.end = build_log_block_end(&range);
+
+    struct text_buffer *line = &ctx->line;
+    struct hash_table path_index = {0};
+    log_save(ctx->log, "\n");
+
+    for (const char *mark = text_range_find(&range, STR_RENAME_MARK);
+         mark != NULL;
+         mark = text_range_find(&range, STR_RENAME_MARK))
+    {
+        /* range 的起始位置总在行首，回退至改名行的行首后读取整行 */
+        const char *line_start = mark;
+        while (line_start > range.start && line_start[-1] != '\n') {
+            line_start--;
+        }
+        range.start = line_start;
+        if (text_range_getline(&range, line) == false) {
+            break;
+        }
+        log_save(ctx->log, "%s", line->data);
+
+        /* 仅在存在改名行时建立路径索引 */
+        if (path_index.buckets == NULL 
+        &&  build_log_path_index_build(ctx, &path_index) == false) 
+        {
+            log_save(ctx->log, "[WARNING] Failed to allocate build_log path index memory\n");
+            break;
+        }
+
+        char *str_p1 = strchr(line->data, '\'');
+        char *str_p2 = str_p1 ? strchr(str_p1 + 1, '\'') : NULL;
+        char *str_p3 = str_p2 ? strrchr(str_p2 + 1, '\'') : NULL;
+        if (str_p3 == NULL) {
+            continue;
+        }
+
+        str_p1 += 1;
+        *str_p2 = '\0';
+        *str_p3 = '\0';
+        char *name = strrchr(str_p2 + 1, '\\');
+        if (name == NULL) {
+            continue;
+        }
+        name += 1;
+
+        struct file_path_list *path_temp = hash_table_find(&path_index, path_separator_normalize(str_p1));
+        if (path_temp)
+        {
+            path_temp->new_object_name = intern_add(&_intern_table, name, str_p3 - name);
+            path_temp->is_rename       = false;
+            log_save(ctx->log, "'%s' rename to '%s'\n", path_temp->old_name, name);
+        }
+    }
+    log_save(ctx->log, "\n");
+    hash_table_free(&path_index);
+    file_mapping_close(&mapping);
+    return;
+}
+
+
+/**
+ * @brief  获取 build_log 文件中改名信息所在区间的末尾
+ * @note   即第一个含有 compiling 而不是改名行的行首。路径中含有 compiling 的改名行不作为结束
+ * @param  range: build_log 文件的文本区间
+ * @retval 区间的末尾，不存在 compiling 行时为 range->end
  */
-bool memory_area_process(const char *str, bool is_new)
+const char * build_log_block_end(const struct text_range *range)
 {
-    static uint8_t id    = 0;
-    static uint8_t state = 0;
-    static uint32_t addr = 0;
-    static uint32_t size = 0;
-    static size_t mem_id = UNKNOWN_MEMORY_ID;
-    static MEMORY_TYPE mem_type = MEMORY_TYPE_NONE;
+    struct text_range rest = *range;
 
-    if (str == NULL || strstr(str, LABEL_END_ONCHIP_MEMORY))
+    for (const char *ptr = text_range_find(&rest, STR_COMPILING);
+         ptr != NULL;
+         ptr = text_range_find(&rest, STR_COMPILING))
     {
-        id       = 0;
-        state    = 0;
-        addr     = 0;
-        size     = 0;
-        mem_id   = UNKNOWN_MEMORY_ID;
-        mem_type = MEMORY_TYPE_NONE;
+        const char *line_start = ptr;
+        while (line_start > rest.start && line_start[-1] != '\n') {
+            line_start--;
+        }
+
+        struct text_range line = {
+            .start = line_start,
+            .end   = _scan.find_byte(ptr, range->end, '\n'),
+        };
+        if (text_range_find(&line, STR_RENAME_MARK) == NULL) {
+            return line_start;
+        }
+        rest.start = line.end;
+    }
+
+    return range->end;
+}
+
+
+/**
+ * @brief  建立 build_log 中文件路径与工程文件的索引
+ * @note   key 为统一分隔符后的路径，忽略大小写，分配自解析上下文的 arena。同一路径被多次添加时仅索引第一个
+ * @param  ctx:   解析上下文
+ * @param  index: [out] 路径索引
+ * @retval true: 成功 | false: 内存不足
+ */
+bool build_log_path_index_build(struct parse_context *ctx, struct hash_table *index)
+{
+    if (hash_table_init(index, ctx->file_list.size, true) == false) {
         return false;
     }
 
-    char *str_p1  = NULL;
-    char *str_p2  = NULL;
-    char *end_ptr = NULL;
+    for (struct file_path_list *path = ctx->file_list.head; path != NULL; path = path->next)
+    {
+        char *key = arena_strndup(&ctx->arena, path->path, intern_get(path->path)->len);
+        if (key == NULL) 
+        {
+            hash_table_free(index);
+            return false;
+        }
+
+        path_separator_normalize(key);
+        if (hash_table_find(index, key) == NULL
+        &&  hash_table_add(index, key, path) == false)
+        {
+            hash_table_free(index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief  统一路径的分隔符
+ * @note   '/' 替换为 '\\'，原地修改
+ * @param  path: 路径
+ * @retval path
+ */
+char * path_separator_normalize(char *path)
+{
+    for (char *ptr = strchr(path, '/'); ptr != NULL; ptr = strchr(ptr + 1, '/')) {
+        *ptr = '\\';
+    }
+    return path;
+}
+
+
+/**
+ * @brief  文件名重名修改处理
+ * @note   与 keil 一致，同名文件中第一个保持原名，其后仍待改名的文件按链表顺序依次添加 _1、_2 ... 后缀。
+ *         按 object_name 分组计数，只遍历一次链表
+ * @param  ctx: 解析上下文
+ * @retval None
+ */
+void file_rename_process(struct parse_context *ctx)
+{
+    struct hash_table group = {0};
+    size_t *repeat = (size_t *)calloc(ctx->file_list.size + 1, sizeof(size_t));
+    size_t group_qty = 0;
+
+    if (repeat == NULL || hash_table_init_intern(&group, ctx->file_list.size, false) == false) {
+        goto __exit;
+    }
+
+    for (struct file_path_list *path_temp = ctx->file_list.head;
+         path_temp != NULL;
+         path_temp = path_temp->next)
+    {
+        size_t *count = (size_t *)hash_table_find(&group, path_temp->object_name);
+        if (count == NULL)
+        {
+            if (hash_table_add(&group, path_temp->object_name, &repeat[group_qty++]) == false) {
+                goto __exit;
+            }
+            continue;
+        }
+        if (path_temp->is_rename == false) {
+            continue;
+        }
+
+        *count += 1;
+
+        /* object_name 即去掉扩展名的 old_name 加上 .o */
+        const struct intern_string *name = intern_get(path_temp->object_name);
+        int stem_len = (int)(name->len - strlen(".o"));
+        int len      = stem_len + snprintf(NULL, 0, "_%zu.o", *count);
+        if (text_buffer_reserve(&ctx->line, len + 1) == false) {
+            goto __exit;
+        }
+
+        char *str = ctx->line.data;
+        snprintf(str, len + 1, "%.*s_%zu.o", stem_len, path_temp->object_name, *count);
+        path_temp->new_object_name = intern_add(&_intern_table, str, len);
+        path_temp->is_rename       = false;
+        log_save(ctx->log, "object '%s' rename to '%s'\n", path_temp->old_name, str);
+    }
+
+__exit:
+    hash_table_free(&group);
+    free(repeat);
+}
+
+
+/**
+ * @brief  自定义 memory area 读取
+ * @note   读取 <OnChipMemories> 中大小不为 0 的 OCR_RVCTx，由 memory_area_add 加入 memory info
+ * @param  ctx:   解析上下文
+ * @param  event: uvprojx 文件的 XML 事件
+ * @retval true: 继续 | false: 结束
+ */
+bool memory_area_process(struct parse_context *ctx, const struct xml_event *event)
+{
+    struct memory_area_state *area = &ctx->memory_area;
+    char str[16];
 
-    switch (state)
+    switch (area->state)
     {
         case 0:
-            if (strstr(str, LABEL_ONCHIP_MEMORY)) {
-                state = 1;
+            if (event->type == XML_EVENT_START && xml_name_is(event, LABEL_ONCHIP_MEMORY)) 
+            {
+                area->id       = 0;
+                area->area_qty = 0;
+                area->state    = 1;
             }
             break;
         case 1:
-            if (strstr(str, LABEL_MEMORY_AREA)) {
-                state = 2;
-            }
-            break;
-        case 2:
-            str_p1 = strstr(str, LABEL_MEMORY_TYPE);
-            if (str_p1)
+            if (event->type == XML_EVENT_START
+            &&  (size_t)(event->name.end - event->name.start) > strlen(LABEL_MEMORY_AREA)
+            &&  memcmp(event->name.start, LABEL_MEMORY_AREA, strlen(LABEL_MEMORY_AREA)) == 0)
             {
-                str_p1 += strlen(LABEL_MEMORY_TYPE);
-                str_p2  = strrchr(str_p1, '<');
-                *str_p2 = '\0';
-
-                if (strtoul(str_p1, &end_ptr, 16) == 0) {
-                    mem_type = MEMORY_TYPE_RAM;
-                } else {
-                    mem_type = MEMORY_TYPE_FLASH;
-                }
-                id++;
-                state = 3;
+                area->id++;
+                area->addr     = 0;
+                area->size     = 0;
+                area->mem_type = MEMORY_TYPE_NONE;
+                area->state    = 2;
             }
-            break;
-        case 3:
-            str_p1 = strstr(str, LABEL_MEMORY_ADDRESS);
-            if (str_p1)
+            else if (event->type == XML_EVENT_END && xml_name_is(event, LABEL_ONCHIP_MEMORY)) 
             {
-                str_p1 += strlen(LABEL_MEMORY_ADDRESS);
-                str_p2  = strrchr(str_p1, '<');
-                *str_p2 = '\0';
-                addr    = strtoul(str_p1, &end_ptr, 16);
-                state   = 4;
+                area->state = 0;
+                return false;
             }
             break;
-        case 4:
-            str_p1 = strstr(str, LABEL_MEMORY_SIZE);
-            if (str_p1)
-            {
-                str_p1 += strlen(LABEL_MEMORY_SIZE);
-                str_p2  = strrchr(str_p1, '<');
-                *str_p2 = '\0';
-                size    = strtoul(str_p1, &end_ptr, 16);
+        case 2:
+            if (event->type != XML_EVENT_END) {
+                break;
+            }
 
-                if (size == 0) {
-                    state = 2;
+            xml_text_copy(event, str, sizeof(str));
+            if (xml_name_is(event, LABEL_MEMORY_TYPE))
+            {
+                if (strtoul(str, NULL, 16) == 0) {
+                    area->mem_type = MEMORY_TYPE_RAM;
                 } else {
-                    state = 5;
-                }
-
-                if (is_new == false) {
-                    break;
-                }
-
-                for (struct memory_info *memory = _memory_info_head;
-                     memory != NULL;
-                     memory = memory->next)
-                {
-                    if (addr >= memory->base_addr
-                    &&  addr <= (memory->base_addr + memory->size))
-                    {
-                        state = 2;
-                        break;
-                    }
+                    area->mem_type = MEMORY_TYPE_FLASH;
                 }
             }
-            break;
-        case 5:
-            if (strstr(str, LABLE_END_MEMORY_AREA))
+            else if (xml_name_is(event, LABEL_MEMORY_ADDRESS)) {
+                area->addr = strtoul(str, NULL, 16);
+            }
+            else if (xml_name_is(event, LABEL_MEMORY_SIZE)) {
+                area->size = strtoul(str, NULL, 16);
+            }
+            else if ((size_t)(event->name.end - event->name.start) > strlen(LABEL_MEMORY_AREA)
+                 &&  memcmp(event->name.start, LABEL_MEMORY_AREA, strlen(LABEL_MEMORY_AREA)) == 0)
             {
-                bool is_offchip = true;
-                if (id == 4 || id == 5 || id == 9 || id == 10) {
-                    is_offchip = false;
+                if (area->size && area->area_qty < MEMORY_AREA_MAX)
+                {
+                    area->area[area->area_qty].id       = area->id;
+                    area->area[area->area_qty].addr     = area->addr;
+                    area->area[area->area_qty].size     = area->size;
+                    area->area[area->area_qty].mem_type = area->mem_type;
+                    area->area_qty++;
                 }
-                mem_id++;
-                memory_info_add(&_memory_info_head, NULL, mem_id, addr, size, mem_type, is_offchip, false);
-                state = 2;
+                area->state = 1;
             }
             break;
         default: break;
@@ -1557,106 +2269,140 @@ bool memory_area_process(const char *str, bool is_new)
 }
 
 
+/**
+ * @brief  将读取到的 memory area 加入 memory info 中
+ * @note   
+ * @param  ctx:     解析上下文
+ * @param  is_new:  是否仅加入与已有 memory 不重叠的 memory area
+ * @retval None
+ */
+void memory_area_add(struct parse_context *ctx, bool is_new)
+{
+    struct memory_area_state *state = &ctx->memory_area;
+    size_t mem_id = UNKNOWN_MEMORY_ID;
+
+    for (size_t i = 0; i < state->area_qty; i++)
+    {
+        const struct memory_area *area = &state->area[i];
+        bool is_overlap = false;
+
+        for (struct memory_info *memory = ctx->memory_list.head;
+             memory != NULL && is_new;
+             memory = memory->next)
+        {
+            if (area->addr >= memory->base_addr
+            &&  area->addr <= (memory->base_addr + memory->size))
+            {
+                is_overlap = true;
+                break;
+            }
+        }
+        if (is_overlap) {
+            continue;
+        }
+
+        bool is_offchip = true;
+        if (area->id == 4 || area->id == 5 || area->id == 9 || area->id == 10) {
+            is_offchip = false;
+        }
+        mem_id++;
+        memory_info_add(&ctx->arena, &ctx->memory_list, NULL, mem_id, area->addr, area->size, area->mem_type, is_offchip, false);
+    }
+}
+
+
 /**
  * @brief  文件路径处理
  * @note   获取 uvprojx 文件中被添加进 keil 工程的文件及其相对路径
- * @param  str:             读取到的 uvprojx 文件的每一行文本
+ * @param  ctx:             解析上下文
+ * @param  event:           uvprojx 文件的 XML 事件
  * @param  is_has_user_lib: [out] 是否有 user lib
  * @retval true: 继续 | false: 结束
  */
-bool file_path_process(const char *str, bool *is_has_user_lib)
+bool file_path_process(struct parse_context *ctx,
+                       const struct xml_event *event, 
+                       bool *is_has_user_lib)
 {
-    static uint8_t state = 0;
-    static char path[MAX_PATH] = {0};
-    static char name[MAX_PRJ_NAME_SIZE] = {0};
-    static OBJECT_FILE_TYPE type = OBJECT_FILE_TYPE_USER;
-
-    char *str_p1 = NULL;
-    char *str_p2 = NULL;
+    struct file_path_state *file = &ctx->file_path;
 
-    if (strstr(str, LABEL_END_GROUPS)) 
+    if (event->type != XML_EVENT_END) {
+        return true;
+    }
+    if (xml_name_is(event, LABEL_GROUPS)) 
     {
-        state = 0;
+        file->state = 0;
         return false;
     }
 
-    switch (state)
+    char type = (event->text.start < event->text.end) ? *event->text.start : '\0';
+
+    switch (file->state)
     {
         case 0:
-            if (strstr(str, LABEL_GROUP_NAME)) {
-                state = 1;
+            if (xml_name_is(event, LABEL_GROUP_NAME)) {
+                file->state = 1;
             }
             break;
         case 1:
-            if (({str_p1 = strstr(str, LABEL_FILE_NAME); str_p1;})) 
+            if (xml_name_is(event, LABEL_FILE_NAME)) 
             {
-                str_p1 += strlen(LABEL_FILE_NAME);
-                str_p2  = strrchr(str_p1, '<');
-                *str_p2 = '\0';
-                strncpy_s(name, sizeof(name), str_p1, strnlen_s(str_p1, sizeof(name)));
-                type  = OBJECT_FILE_TYPE_USER;
-                state = 2;
-            }
-            else if (({str_p1 = strstr(str, LABEL_INCLUDE_IN_BUILD); str_p1;}))
+                file->name  = event->text;
+                file->type  = OBJECT_FILE_TYPE_USER;
+                file->state = 2;
+            }
+            else if (xml_name_is(event, LABEL_INCLUDE_IN_BUILD))
             {
-                str_p1 += strlen(LABEL_INCLUDE_IN_BUILD);
-                if (*str_p1 == '0') {
-                    state = 0;
+                /* 整个 group 不参与编译 */
+                if (xml_text_is_zero(event)) {
+                    file->state = 0;
                 }
             }
-            else if (strstr(str, LABEL_END_FILES)) {
-                state = 0;
+            else if (xml_name_is(event, LABEL_FILES)) {
+                file->state = 0;
             }
             break;
         case 2:
-            str_p1 = strstr(str, LABEL_FILE_TYPE);
-            if (str_p1) 
+            if (xml_name_is(event, LABEL_FILE_TYPE)) 
             {
-                str_p1 += strlen(LABEL_FILE_TYPE);
                 /* text document file or custom file */
-                if (*str_p1 == '5' || *str_p1 == '6') {
-                    state = 1;
+                if (type == '5' || type == '6') {
+                    file->state = 1;
                 } 
-                else if (*str_p1 == '3')    /* object file */
+                else if (type == '3')    /* object file */
                 {
-                    type  = OBJECT_FILE_TYPE_OBJECT;
-                    state = 3;
+                    file->type  = OBJECT_FILE_TYPE_OBJECT;
+                    file->state = 3;
                 }
-                else if (*str_p1 == '4')    /* library file */
+                else if (type == '4')    /* library file */
                 {
                     *is_has_user_lib = true;
-                    type  = OBJECT_FILE_TYPE_LIBRARY;
-                    state = 3;
+                    file->type  = OBJECT_FILE_TYPE_LIBRARY;
+                    file->state = 3;
                 }
                 else {
-                    state = 3;
+                    file->state = 3;
                 }
             }
             break;
         case 3:
-            str_p1 = strstr(str, LABEL_FILE_PATH);
-            if (str_p1) 
+            if (xml_name_is(event, LABEL_FILE_PATH)) 
             {
-                str_p1 += strlen(LABEL_FILE_PATH);
-                str_p2  = strrchr(str_p1, '<');
-                *str_p2 = '\0';
-                strncpy_s(path, sizeof(path), str_p1, strnlen_s(str_p1, sizeof(path)));
-                state = 4;
+                file->path  = event->text;
+                file->state = 4;
             }
             break;
         case 4:
-            if (strstr(str, LABEL_END_FILE)) 
+            if (xml_name_is(event, LABEL_FILE)) 
             {
-                file_path_add(&_file_path_list_head, name, path, type);
-                state = 1;
+                file_path_add(ctx, &file->name, &file->path, file->type);
+                file->state = 1;
             }
-            else if (({str_p1 = strstr(str, LABEL_INCLUDE_IN_BUILD); str_p1;}))
+            else if (xml_name_is(event, LABEL_INCLUDE_IN_BUILD))
             {
-                str_p1 += strlen(LABEL_INCLUDE_IN_BUILD);
-                if (*str_p1 != '0') {
-                    file_path_add(&_file_path_list_head, name, path, type);
+                if (xml_text_is_zero(event) == false) {
+                    file_path_add(ctx, &file->name, &file->path, file->type);
                 }
-                state = 1;
+                file->state = 1;
             }
             break;
         default: break;
@@ -1669,89 +2415,204 @@ bool file_path_process(const char *str, bool *is_has_user_lib)
 /**
  * @brief  map 文件处理
  * @note   获取 map 文件中每个编译文件的信息
+ * @param  ctx:             解析上下文
  * @param  file_path:       map 文件的绝对路径
- * @param  region_head:     region 链表头
- * @param  object_head:     object 文件链表头
+ * @param  region_list:     region 链表
+ * @param  object_list:     object 文件链表
+ * @param  is_get_object:   是否获取 object 信息，为 false 时不读取 Image component sizes
  * @param  is_has_user_lib: 是否获取 user lib 信息
  * @param  is_match_memory: 是否要匹配存储器信息
  * @retval 0: 正常 | -x: 错误
  */
-int map_file_process(const char *file_path, 
-                     struct load_region **region_head,
-                     struct object_info **object_head,
+int map_file_process(struct parse_context *ctx,
+                     const char *file_path, 
+                     struct region_list *region_list,
+                     struct object_list *object_list,
+                     bool is_get_object,
                      bool is_get_user_lib,
                      bool is_match_memory)
 {
-    FILE *p_file = fopen(file_path, "r");
-    if (p_file == NULL) {
+    /* 将整个 map 文件映射至内存 */
+    struct file_mapping mapping;
+    if (file_mapping_open(&mapping, file_path) == false) {
         return -1;
     }
 
-    /* 读取 map 文件 */
-    fseek(p_file, 0, SEEK_END);
-    long pos_head = ftell(p_file);
-    long pos_end  = pos_head;
-    long memory_map_pos = 0;
+    LARGE_INTEGER freq, start, stop;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&start);
 
-    /* 从文件末尾开始逆序读取 */
-    while (pos_head)
+    /* 一次正序遍历，建立各段落的索引 */
+    struct map_index index;
+    map_index_build(&index, mapping.data, mapping.size);
+
+    for (size_t i = 0; i < MAP_SECTION_QTY; i++)
     {
-        fseek(p_file, pos_head, SEEK_SET);
-        if (fgetc(p_file) == '\n' && (pos_end - pos_head) > 1)
+        if (index.section[i].start) 
         {
-            fseek(p_file, pos_head + 1, SEEK_SET);
-            fgets(_line_text, sizeof(_line_text), p_file);
-            pos_end = pos_head;
-
-            if (strstr(_line_text, STR_MEMORY_MAP_OF_THE_IMAGE))
-            {
-                /* 记录位置并退出循环 */
-                memory_map_pos = ftell(p_file);
-                break;
-            }
+            log_save(ctx->log, "[map section %zu] 0x%.8X - 0x%.8X\n", i, 
+                     (unsigned int)(index.section[i].start - mapping.data), 
+                     (unsigned int)(index.section[i].end - mapping.data));
         }
-        pos_head--;
     }
 
-    if (pos_head == 0)
+    struct map_section *section = &index.section[MAP_SECTION_MEMORY_MAP];
+    if (section->start == NULL)
     {
-        fclose(p_file);
+        file_mapping_close(&mapping);
         return -2;
     }
 
     /* 获取 map 文件中的 load region 和 execution region 信息 */
-    region_info_process(p_file, memory_map_pos, region_head, is_match_memory);
+    struct text_range range = {
+        .start = section->start,
+        .end   = section->end,
+    };
+    region_info_process(ctx, &range, region_list, is_match_memory);
 
     /* 获取每个 .o 文件的 flash 和 RAM 占用情况 */
-    return object_info_process(object_head, p_file, NULL, is_get_user_lib, 0);
+    int result = 0;
+    section = &index.section[MAP_SECTION_COMPONENT_SIZES];
+    if (is_get_object && section->start)
+    {
+        range.start = section->start;
+        range.end   = section->end;
+
+        /* 不需要 user lib 时，只读取到 Object Totals */
+        if (is_get_user_lib == false && index.totals[MAP_TOTALS_OBJECT]) {
+            range.end = index.totals[MAP_TOTALS_OBJECT];
+        }
+        result = object_info_process(ctx, object_list, &range, is_get_user_lib);
+    }
+    else if (is_get_object) {
+        result = -3;
+    }
+
+    QueryPerformanceCounter(&stop);
+    double seconds = (double)(stop.QuadPart - start.QuadPart) / freq.QuadPart;
+    log_save(ctx->log, "[map file size] %zu byte(s) [parse time] %.6f s [speed] %.1f MB/s\n", 
+             mapping.size, seconds, seconds > 0 ? mapping.size / seconds / (1024 * 1024) : 0.0);
+
+    file_mapping_close(&mapping);
+    return result;
+}
+
+
+/**
+ * @brief  建立 map 文件的段落索引
+ * @note   仅正序遍历一次。顶层段落的标题位于行首，Totals 仅在 Image component sizes 中查找
+ * @param  index:   [out] 段落索引
+ * @param  data:    map 文件内容
+ * @param  size:    map 文件大小
+ * @retval None
+ */
+void map_index_build(struct map_index *index, 
+                     const char *data, 
+                     size_t size)
+{
+    static const char *section_title[MAP_SECTION_QTY] = 
+    {
+        [MAP_SECTION_CROSS_REFERENCES] = STR_SECTION_CROSS_REFERENCES,
+        [MAP_SECTION_REMOVING_UNUSED]  = STR_REMOVING_UNUSED_SECTIONS,
+        [MAP_SECTION_SYMBOL_TABLE]     = STR_IMAGE_SYMBOL_TABLE,
+        [MAP_SECTION_MEMORY_MAP]       = STR_MEMORY_MAP_OF_THE_IMAGE,
+        [MAP_SECTION_COMPONENT_SIZES]  = STR_IMAGE_COMPONENT_SIZE,
+    };
+    static const char *totals_title[MAP_TOTALS_QTY] = 
+    {
+        [MAP_TOTALS_OBJECT]         = STR_OBJECT_TOTALS,
+        [MAP_TOTALS_LIBRARY_MEMBER] = STR_LIBRARY_TOTALS,
+        [MAP_TOTALS_LIBRARY]        = STR_LIBRARY_TOTALS,
+        [MAP_TOTALS_GRAND]          = STR_GRAND_TOTALS,
+        [MAP_TOTALS_ELF_IMAGE]      = STR_ELF_IMAGE_TOTALS,
+        [MAP_TOTALS_ROM]            = STR_ROM_TOTALS,
+    };
+
+    memset(index, 0, sizeof(struct map_index));
+
+    int current = -1;
+    const char *end = data + size;
+
+    for (const char *line = data; line < end; )
+    {
+        const char *line_end = _scan.find_byte(line, end, '\n');
+        const char *next     = (line_end < end) ? line_end + 1 : end;
+        size_t len = line_end - line;
+
+        if (len && line[len - 1] == '\r') {
+            len--;
+        }
+
+        /* 顶层段落的标题没有缩进 */
+        if (len && line[0] != ' ' && line[0] != '\t')
+        {
+            for (size_t i = 0; i < MAP_SECTION_QTY; i++)
+            {
+                size_t title_len = strlen(section_title[i]);
+                if (len >= title_len && memcmp(line, section_title[i], title_len) == 0)
+                {
+                    if (current >= 0) {
+                        index->section[current].end = line;
+                    }
+                    index->section[i].start = next;
+                    index->section[i].end   = end;
+                    current = i;
+                    break;
+                }
+            }
+        }
+        /* Totals 为行尾的名称 */
+        else if (current == MAP_SECTION_COMPONENT_SIZES && len)
+        {
+            for (size_t i = 0; i < MAP_TOTALS_QTY; i++)
+            {
+                size_t title_len = strlen(totals_title[i]);
+                if (index->totals[i] == NULL
+                &&  len >= title_len 
+                &&  memcmp(line + len - title_len, totals_title[i], title_len) == 0)
+                {
+                    index->totals[i] = line;
+                    break;
+                }
+            }
+        }
+        line = next;
+    }
 }
 
 
 /**
  * @brief  获取 load region 和 execution region 信息
  * @note   
- * @param  p_file:          文件对象
- * @param  read_start_pos:  开始读取的位置
- * @param  region_head:     region 链表头
- * @param  is_match_memory: 是否要将 region 与 memory 绑定
+ * @param  ctx:             解析上下文
+ * @param  range:           要解析的文本区间，解析后起始位置后移至已读取的位置
+ * @param  region_list:     region 链表
+ * @param  is_match_memory: 是否要将 region 与 memory 绑定，绑定时 region 的基地址须位于 memory 的 [基地址, 基地址 + 大小) 中
  * @retval 0: 正常 | -5: 获取失败
  */
-int region_info_process(FILE *p_file, 
-                        long read_start_pos, 
-                        struct load_region **region_head,
+int region_info_process(struct parse_context *ctx,
+                        struct text_range *range, 
+                        struct region_list *region_list,
                         bool is_match_memory)
 {
-    /* 先从记录的位置开始正序读取 */
-    fseek(p_file, read_start_pos, SEEK_SET);
-
     bool is_has_load_region = false;
     uint8_t size_pos = 2;
     struct load_region *l_region = NULL;
     struct exec_region *e_region = NULL;
+    struct text_buffer *line     = &ctx->line;
+    struct keyword_match match;
+    struct memory_index memory_index = {0};
+
+    if (is_match_memory 
+    &&  memory_index_build(&ctx->arena, &memory_index, &ctx->memory_list) == false) 
+    {
+        return -5;
+    }
     
-    while (fgets(_line_text, sizeof(_line_text), p_file))
+    while (text_range_getline(range, line))
     {
-        if (strstr(_line_text, STR_IMAGE_COMPONENT_SIZE)) {
+        uint32_t found = keyword_match_line(&_keyword_matcher, line->data, line->size, &match);
+        if (found & KEYWORD_BIT(KEYWORD_IMAGE_COMPONENT_SIZE)) {
             return 0;
         }
 
@@ -1759,42 +2620,39 @@ int region_info_process(FILE *p_file,
         char *str_p1  = NULL;
         char *str_p2  = NULL;
         char *end_ptr = NULL;
-        char name[MAX_PRJ_NAME_SIZE] = {0};
+        struct text_range name;
         uint32_t base_addr = 0;
         uint32_t size      = 0;
         uint32_t used_size = 0;
         size_t memory_id   = 0;
         MEMORY_TYPE memory_type = MEMORY_TYPE_NONE;
         
-        str_p1 = strstr(_line_text, STR_LOAD_REGION);
-        if (str_p1)
+        if (found & KEYWORD_BIT(KEYWORD_LOAD_REGION))
         {
+            str_p1  = (char *)match.pos[KEYWORD_LOAD_REGION];
             str_p1 += strlen(STR_LOAD_REGION) + 1;
-            str_p2  = strstr(str_p1, " ");
-            *str_p2 = '\0';
-            strncpy_s(name, sizeof(name), str_p1, strnlen_s(str_p1, sizeof(name)));
+            name    = (struct text_range){str_p1, _scan.find_byte(str_p1, line->data + line->size, ' ')};
 
-            l_region = load_region_create(region_head, name);
+            l_region = load_region_create(&ctx->arena, region_list, &name);
             is_has_load_region = true;
         }
         else if (is_has_load_region)
         {
-            str_p1 = strstr(_line_text, STR_EXECUTION_REGION);
-            if (str_p1)
+            if (found & KEYWORD_BIT(KEYWORD_EXECUTION_REGION))
             {
-                if (strstr(_line_text, STR_LOAD_BASE)) {
+                if (found & KEYWORD_BIT(KEYWORD_LOAD_BASE)) {
                     size_pos = 3;
                 }
 
+                str_p1  = (char *)match.pos[KEYWORD_EXECUTION_REGION];
                 str_p1 += strlen(STR_EXECUTION_REGION) + 1;
-                str_p2  = strstr(str_p1, " ");
-                *str_p2 = '\0';
-                strncpy_s(name, sizeof(name), str_p1, strnlen_s(str_p1, sizeof(name)));
+                str_p2  = (char *)_scan.find_byte(str_p1, line->data + line->size, ' ');
+                name    = (struct text_range){str_p1, str_p2};
 
-                str_p1 = strstr(str_p2 + 1, STR_EXECUTE_BASE_ADDR);
+                str_p1 = strstr(str_p2, STR_EXECUTE_BASE_ADDR);
                 if (str_p1 == NULL)
                 {
-                    str_p1 = strstr(str_p2 + 1, STR_EXECUTE_BASE);
+                    str_p1 = strstr(str_p2, STR_EXECUTE_BASE);
                     if (str_p1 == NULL) {
                         return -5;
                     }
@@ -1824,36 +2682,32 @@ int region_info_process(FILE *p_file,
                 memory_id   = UNKNOWN_MEMORY_ID;
                 memory_type = MEMORY_TYPE_UNKNOWN;
 
-                if (is_match_memory)
+                /* 将 execution region 与 对应的 memory 绑定  */
+                const struct memory_info *memory = memory_index_find(&memory_index, base_addr);
+                if (memory)
                 {
-                    /* 将 execution region 与 对应的 memory 绑定  */
-                    for (struct memory_info *memory_temp = _memory_info_head;
-                         memory_temp != NULL;
-                         memory_temp = memory_temp->next)
-                    {
-                        if (base_addr >= memory_temp->base_addr
-                        &&  base_addr <= (memory_temp->base_addr + memory_temp->size))
-                        {
-                            is_offchip  = memory_temp->is_offchip;
-                            memory_id   = memory_temp->id;
-                            memory_type = memory_temp->type;
-                            break;
-                        }
-                    }
+                    is_offchip  = memory->is_offchip;
+                    memory_id   = memory->id;
+                    memory_type = memory->type;
                 }
 
-                region_zi_process(NULL, NULL, 0);
-                e_region = load_region_add_exec_region(&l_region, name, memory_id, base_addr, size, used_size, memory_type, is_offchip);
+                region_zi_process(ctx, NULL, NULL, 0, 0);
+                e_region = load_region_add_exec_region(&ctx->arena, l_region, &name, memory_id, base_addr, size, used_size, memory_type, is_offchip);
             }
             else if (e_region 
             &&       e_region->memory_type != MEMORY_TYPE_FLASH
-            &&       strstr(_line_text, "0x"))
+            &&       (found & KEYWORD_BIT(KEYWORD_HEX)))
             {
-                region_zi_process(&e_region, _line_text, size_pos);
+                struct text_range text = {line->data, line->data + line->size};
+                region_zi_process(ctx, e_region, &text, size_pos, found);
             }
         }
     }
 
+    /* 区间已读取完毕 */
+    if (is_has_load_region) {
+        return 0;
+    }
     return -5;
 }
 
@@ -1862,1562 +2716,5749 @@ int region_info_process(FILE *p_file,
  * @brief  获取 region 中的 zero init 区域块分布
  * @note   e_region 参数传值为 NULL 时将复位本函数。
  *         切换至新的 execution region 前，必须复位本函数
+ * @param  ctx:         解析上下文
  * @param  e_region:    execution region
  * @param  text:        一行文本内容
  * @param  size_pos:    Size 栏目所在的位置，从 1 算起
+ * @param  found:       该行文本中找到的关键字
  * @retval None
  */
-void region_zi_process(struct exec_region **e_region,
-                       char *text,
-                       size_t size_pos)
+void region_zi_process(struct parse_context *ctx,
+                       struct exec_region *e_region,
+                       const struct text_range *text,
+                       size_t size_pos,
+                       uint32_t found)
 {
-    static bool is_zi_start = false;
-    static uint32_t last_end_addr = 0;
-    static struct region_block **zi_block = NULL;
+    struct region_zi_state *zi = &ctx->region_zi;
 
     if (e_region == NULL) 
     {
-        zi_block      = NULL;
-        is_zi_start   = false;
-        last_end_addr = 0;
+        zi->zi_block      = NULL;
+        zi->is_zi_start   = false;
+        zi->last_end_addr = 0;
         return;
     }
 
-    if (strstr(text, STR_ZERO_INIT)) {
-        is_zi_start = true;
+    if (found & KEYWORD_BIT(KEYWORD_ZERO_INIT)) {
+        zi->is_zi_start = true;
     }
-    else if (strstr(text, STR_PADDING)) 
+    else if (found & KEYWORD_BIT(KEYWORD_PADDING)) 
     { 
-        if (is_zi_start == false) {
+        if (zi->is_zi_start == false) {
             return;
         }
     }
     else 
     {
-        zi_block      = NULL;
-        is_zi_start   = false;
-        last_end_addr = 0;
+        zi->zi_block      = NULL;
+        zi->is_zi_start   = false;
+        zi->last_end_addr = 0;
         return;
     }
 
-    char *addr_token = strtok(text, " ");
-    for (size_t i = 2; i < size_pos; i++) {
-        strtok(NULL, " ");
+    /* 字段以空格结束，strtoul 无需复制字段 */
+    struct text_range rest = *text;
+    struct text_range addr_token, size_token;
+    bool is_ok = text_range_field(&rest, &addr_token);
+    for (size_t i = 1; i < size_pos && is_ok; i++) {
+        is_ok = text_range_field(&rest, &size_token);
+    }
+    if (is_ok == false) {
+        return;
     }
-    char *size_token = strtok(NULL, " ");
 
-    char *end_ptr = NULL;
-    uint32_t addr = strtoul(addr_token, &end_ptr, 16);
-    uint32_t size = strtoul(size_token, &end_ptr, 16);
+    uint32_t addr = strtoul(addr_token.start, NULL, 16);
+    uint32_t size = strtoul(size_token.start, NULL, 16);
 
-    if (addr > last_end_addr) 
+    if (addr > zi->last_end_addr) 
     {
-        zi_block = &(*e_region)->zi_block;
+        zi->zi_block = (struct region_block *)arena_alloc(&ctx->arena, sizeof(struct region_block));
+        if (zi->zi_block == NULL) {
+            return;
+        }
+        zi->zi_block->start_addr = addr;
+        zi->zi_block->size       = size;
+        zi->zi_block->next       = NULL;
 
-        if (*zi_block)
-        {
-            struct region_block *block = *zi_block;
+        if (e_region->zi_block_tail) {
+            e_region->zi_block_tail->next = zi->zi_block;
+        } else {
+            e_region->zi_block = zi->zi_block;
+        }
+        e_region->zi_block_tail = zi->zi_block;
+    }
+    else if (zi->zi_block) {
+        zi->zi_block->size += size;
+    }
 
-            while (block->next) {
-                block = block->next;
-            }
-            zi_block = &block->next;
+    zi->last_end_addr = addr + size;
+}
+
+
+/**
+ * @brief  解析 Image component size 表中的一行
+ * @note   依次为 6 个十进制数及名称，以空格分隔，与 strtok_s 的切分相同。
+ *         名称只取一个字段，在行内以 '\0' 结尾，行被修改或重新读取前有效
+ * @param  text: 一行文本内容，须以 '\0' 结尾
+ * @param  len:  文本的长度
+ * @param  row:  [out] 解析的内容
+ * @retval true: 成功 | false: 字段数量不足
+ */
+bool object_row_decode(char *text, size_t len, struct object_row *row)
+{
+    const char *ptr = text;
+    const char *end = text + len;
+
+    for (size_t i = 0; i < OBJECT_INFO_STR_QTY - 1; i++)
+    {
+        ptr = _scan.skip_byte(ptr, end, ' ');
+        if (ptr == end) {
+            return false;
+        }
+
+        /* 数字之后通常就是分隔符，无需再查找 */
+        ptr = text_decimal_parse(ptr, end, &row->value[i]);
+        if (ptr < end && *ptr != ' ') {
+            ptr = _scan.find_byte(ptr, end, ' ');
         }
+    }
 
-        *zi_block = (struct region_block *)malloc(sizeof(struct region_block));
-        (*zi_block)->start_addr = addr;
-        (*zi_block)->size       = size;
-        (*zi_block)->next       = NULL;
+    struct text_range rest = {ptr, end};
+    if (text_range_field(&rest, &row->name) == false) {
+        return false;
     }
-    else if (*zi_block) {
-        (*zi_block)->size += size;
+
+    if (row->name.end[-1] == '\n') {
+        row->name.end--;
     }
+    text[row->name.end - text] = '\0';
 
-    last_end_addr = addr + size;
+    return true;
 }
 
 
 /**
  * @brief  获取 object info
  * @note   
- * @param  object_head:     object 文件链表头
- * @param  p_file:          文件对象
- * @param  end_pos:         [out] 最后读取到的文件位置
+ * @param  ctx:             解析上下文
+ * @param  object_list:     object 文件链表
+ * @param  range:           要解析的文本区间，读取到 object 信息结尾时起始位置后移至已读取的位置
  * @param  is_get_user_lib: 是否获取用户 lib 信息
- * @param  parse_mode:      解析模式 0: 按 map 文件解析 | 1: 按 record 文件解析
  * @retval 0: 正常 | -x: 错误
  */
-int object_info_process(struct object_info **object_head,
-                        FILE *p_file,
-                        long *end_pos,
-                        bool is_get_user_lib,
-                        uint8_t parse_mode)
+int object_info_process(struct parse_context *ctx,
+                        struct object_list *object_list,
+                        struct text_range *range,
+                        bool is_get_user_lib)
 {
     int result     = 0;
     uint8_t state  = 0;
-    uint32_t value[16] = {0};
-    char name[MAX_PRJ_NAME_SIZE] = {0};
-    char *token    = NULL;
-    char *end_ptr  = NULL;
-    char *new_line = NULL;
-    size_t index   = 0;
+    struct text_range text = *range;
+    struct text_buffer *line = &ctx->line;
+    struct keyword_match match;
+    struct object_row row;
 
     /* 获取用户文件的 object info */
-    while (fgets(_line_text, sizeof(_line_text), p_file))
+    while (text_range_getline(&text, line))
     {
+        uint32_t found = keyword_match_line(&_keyword_matcher, line->data, line->size, &match);
+        bool is_row    = false;
+        const struct hash_table *filter = NULL;     /* 为 NULL 时全部添加 */
+
         switch (state)
         {
             case 0:
-                if (parse_mode == 0)
-                {
-                    /* Object Name 全部添加 */
-                    if (strstr(_line_text, ".o")) 
-                    {
-                        index = 0;
-                        /* 切割后转换 */
-                        token = strtok(_line_text, " ");
-                        while (token != NULL)
-                        {
-                            if (index < OBJECT_INFO_STR_QTY - 1) {
-                                value[index] = strtoul(token, &end_ptr, 10);
-                            } 
-                            else    /* 最后一个是名称 */
-                            {
-                                new_line = strrchr(token, '\n');
-                                if (new_line) {
-                                    *new_line = '\0';
-                                }
-                                strncpy_s(name, sizeof(name), token, strnlen_s(token, sizeof(name)));
-                            }
-                            if (++index == OBJECT_INFO_STR_QTY) {
-                                break;
-                            }
-                            token = strtok(NULL, " ");
-                        }
-
-                        /* 保存 */
-                        if (index == OBJECT_INFO_STR_QTY) {
-                            object_info_add(object_head, name, value[0], value[2], value[3], value[4]);
-                        } 
-                        else 
-                        {
-                            result = -3;
-                            break;
-                        }
-                    }
-                    else if (strstr(_line_text, STR_LIBRARY_MEMBER_NAME)) 
-                    {
-                        if (is_get_user_lib) {
-                            state = 1;
-                        } else {
-                            state = 3;
-                        }
-                    }
+                /* Object Name 全部添加 */
+                if (found & KEYWORD_BIT(KEYWORD_OBJECT_FILE)) {
+                    is_row = true;
                 }
-                else if (parse_mode == 1)
+                else if (found & KEYWORD_BIT(KEYWORD_LIBRARY_MEMBER_NAME)) 
                 {
-                    if (strstr(_line_text, STR_OBJECT_NAME)) {
-                        state = 2;
+                    if (is_get_user_lib) {
+                        state = 1;
+                    } else {
+                        state = 3;
                     }
                 }
                 break;
             case 1:
                 /* Library Member Name 仅添加匹配的 object */
-                if (strstr(_line_text, ".o")) 
+                if (found & KEYWORD_BIT(KEYWORD_OBJECT_FILE)) 
                 {
-                    index = 0;
-                    /* 切割后转换 */
-                    token = strtok(_line_text, " ");
-                    while (token != NULL)
-                    {
-                        if (index < OBJECT_INFO_STR_QTY - 1) {
-                            value[index] = strtoul(token, &end_ptr, 10);
-                        } 
-                        else    /* 最后一个是名称 */
-                        {
-                            new_line = strrchr(token, '\n');
-                            if (new_line) {
-                                *new_line = '\0';
-                            }
-                            strncpy_s(name, sizeof(name), token, strnlen_s(token, sizeof(name)));
-                        }
-                        if (++index == OBJECT_INFO_STR_QTY) {
-                            break;
-                        }
-                        token = strtok(NULL, " ");
-                    }
-
-                    /* 保存 */
-                    if (index == OBJECT_INFO_STR_QTY) 
-                    {
-                        for (struct file_path_list *path_temp = _file_path_list_head; 
-                             path_temp != NULL; 
-                             path_temp = path_temp->next)
-                        {
-                            if (path_temp->file_type == OBJECT_FILE_TYPE_LIBRARY)
-                            {
-                                if (strcasecmp(name, path_temp->new_object_name) == 0) 
-                                {
-                                    object_info_add(object_head, name, value[0], value[2], value[3], value[4]);
-                                    break;
-                                }
-                            }
-                        }
-                    }
+                    is_row = true;
+                    filter = &ctx->file_path_index.library_object;
                 }
-                else if (strstr(_line_text, STR_LIBRARY_NAME)) {
+                else if (found & KEYWORD_BIT(KEYWORD_LIBRARY_NAME)) {
                     state = 2;
                 }
                 break;
             case 2:
                 /* Library Member Name 仅添加匹配的 object */
-                if (strstr(_line_text, STR_OBJECT_TOTALS)) 
-                {
+                if (found & KEYWORD_BIT(KEYWORD_OBJECT_TOTALS)) {
                     state = 3;
-                    break;
                 }
                 else
                 {
-                    index = 0;
-                    /* 切割后转换 */
-                    token = strtok(_line_text, " ");
-                    while (token != NULL)
-                    {
-                        if (index < OBJECT_INFO_STR_QTY - 1) {
-                            value[index] = strtoul(token, &end_ptr, 10);
-                        } 
-                        else    /* 最后一个是名称 */
-                        {
-                            new_line = strrchr(token, '\n');
-                            if (new_line) {
-                                *new_line = '\0';
-                            }
-                            strncpy_s(name, sizeof(name), token, strnlen_s(token, sizeof(name)));
-                        }
-                        if (++index == OBJECT_INFO_STR_QTY) {
-                            break;
-                        }
-                        token = strtok(NULL, " ");
-                    }
-
-                    /* 保存 */
-                    if (index == OBJECT_INFO_STR_QTY) 
-                    {
-                        if (parse_mode == 1)
-                        {
-                            object_info_add(object_head, name, value[0], value[2], value[3], value[4]);
-                            break;
-                        }
-
-                        for (struct file_path_list *path_temp = _file_path_list_head; 
-                             path_temp != NULL; 
-                             path_temp = path_temp->next)
-                        {
-                            if (path_temp->file_type == OBJECT_FILE_TYPE_LIBRARY)
-                            {
-                                if (strcasecmp(name, path_temp->old_name) == 0) 
-                                {
-                                    object_info_add(object_head, name, value[0], value[2], value[3], value[4]);
-                                    break;
-                                }
-                            }
-                        }
-                    }
+                    is_row = true;
+                    filter = &ctx->file_path_index.library;
                 }
                 break;
             default: break;
         }
 
-        if (state == 3 || result != 0) {
+        if (state == 3) {
             break;
         }
-    }
+        if (is_row == false) {
+            continue;
+        }
 
-    if (state == 3) 
-    {
-        if (end_pos) {
-            *end_pos = ftell(p_file);
+        if (object_row_decode(line->data, line->size, &row) == false)
+        {
+            /* 用户文件的行必须完整，lib 的行不完整时忽略 */
+            if (filter == NULL) 
+            {
+                result = -3;
+                break;
+            }
+            continue;
+        }
+
+        /* lib 的索引均忽略大小写，按 fold 字符串查找。忽略大小写后仍不在 intern 表中的名称无需查找 */
+        const char *name = NULL;
+        if (filter) {
+            name = intern_find_nocase(&_intern_table, row.name.start, row.name.end - row.name.start);
+        }
+
+        /* 保存 */
+        if (filter == NULL || (name && hash_table_find(filter, name))) {
+            object_info_add(&ctx->arena, object_list, &row.name, 
+                            row.value[0], row.value[2], row.value[3], row.value[4]);
         }
     }
-    fclose(p_file);
+
+    if (state == 3) {
+        *range = text;
+    }
     return result;
 }
 
 
 /**
- * @brief  记录文件处理
+ * @brief  检查记录文件中的段是否位于文件范围内
  * @note   
- * @param  file_path:       文件的绝对路径
- * @param  region_head:     region 链表头
- * @param  object_head:     object 文件链表头
- * @param  is_has_object:   [out] 是否存在 object 信息
- * @param  is_has_region:   [out] 是否存在 region 信息
- * @param  is_match_memory: 是否要将 region 与 memory 绑定
- * @retval 0: 正常 | -x: 错误
+ * @param  file_size:   记录文件大小
+ * @param  offset:      段的偏移
+ * @param  qty:         段中元素的数量
+ * @param  item_size:   元素的大小
+ * @retval true: 有效 | false: 无效
  */
-int record_file_process(const char *file_path, 
-                        struct load_region **region_head,
-                        struct object_info **object_head,
-                        bool *is_has_object,
-                        bool *is_has_region,
-                        bool is_match_memory)
+bool record_section_check(size_t file_size, 
+                          uint32_t offset, 
+                          uint32_t qty, 
+                          size_t item_size)
 {
-    *is_has_object = false;
-    *is_has_region = false;
+    if ((offset % sizeof(uint32_t)) != 0 || offset > file_size) {
+        return false;
+    }
+    return ((file_size - offset) / item_size) >= qty;
+}
 
-    FILE *p_file = fopen(file_path, "r");
-    if (p_file == NULL) {
-        return -1;
+
+/**
+ * @brief  打开记录
+ * @note   校验记录的内容，校验通过后各段直接使用记录的内容，无需解析
+ * @param  record: [out] 记录
+ * @param  data:   记录的内容，须 4 字节对齐
+ * @param  size:   记录的大小
+ * @retval 0: 正常 | -2: 格式或版本不符
+ */
+int record_view_open(struct record_view *record, 
+                     const char *data, 
+                     size_t size)
+{
+    memset(record, 0, sizeof(struct record_view));
+
+    const struct record_header *header = (const struct record_header *)data;
+
+    if (size < sizeof(struct record_header)
+    ||  header->magic != RECORD_MAGIC
+    ||  header->version != RECORD_VERSION
+    ||  header->file_size != size
+    ||  record_section_check(size, header->object_offset,      header->object_qty,      sizeof(struct record_object)) == false
+    ||  record_section_check(size, header->load_region_offset, header->load_region_qty, sizeof(struct record_load_region)) == false
+    ||  record_section_check(size, header->exec_region_offset, header->exec_region_qty, sizeof(struct record_exec_region)) == false
+    ||  record_section_check(size, header->string_offset,      header->string_size,     sizeof(char)) == false
+    ||  header->string_size == 0
+    ||  data[header->string_offset + header->string_size - 1] != '\0')
+    {
+        return -2;
     }
 
-    long end_pos = 0;
-    int result = object_info_process(object_head, p_file, &end_pos, false, 1);
-    if (result == 0) {
-        *is_has_object = true;
+    const struct record_object *object           = (const struct record_object *)(data + header->object_offset);
+    const struct record_load_region *load_region = (const struct record_load_region *)(data + header->load_region_offset);
+    const struct record_exec_region *exec_region = (const struct record_exec_region *)(data + header->exec_region_offset);
+
+    /* 字符串表以 '\0' 结尾，名称的偏移在范围内即可保证字符串有效 */
+    bool is_valid = true;
+    for (uint32_t i = 0; i < header->object_qty && is_valid; i++) {
+        is_valid = (object[i].name < header->string_size);
+    }
+    for (uint32_t i = 0; i < header->load_region_qty && is_valid; i++) 
+    {
+        is_valid = (load_region[i].name < header->string_size
+                &&  load_region[i].exec_region_index <= header->exec_region_qty
+                &&  load_region[i].exec_region_qty <= header->exec_region_qty - load_region[i].exec_region_index);
+    }
+    for (uint32_t i = 0; i < header->exec_region_qty && is_valid; i++) {
+        is_valid = (exec_region[i].name < header->string_size);
     }
 
-    p_file = fopen(file_path, "r");
-    if (p_file == NULL) {
+    if (is_valid == false) {
+        return -2;
+    }
+
+    record->header      = header;
+    record->object      = object;
+    record->load_region = load_region;
+    record->exec_region = exec_region;
+    record->string      = data + header->string_offset;
+
+    return 0;
+}
+
+
+/**
+ * @brief  打开记录存储文件
+ * @note   将记录存储文件映射至内存，校验文件头并按 key 建立索引。各记录在查找时校验
+ * @param  store:     [out] 记录存储
+ * @param  file_path: 记录存储文件的绝对路径
+ * @param  magic:     文件的 magic，区分记录文件与分析缓存文件
+ * @retval 0: 正常 | -1: 无法打开 | -2: 格式或版本不符 | -3: 内存不足
+ */
+int record_store_open(struct record_store *store, 
+                      const char *file_path, 
+                      uint32_t magic)
+{
+    memset(store, 0, sizeof(struct record_store));
+
+    if (file_mapping_open(&store->mapping, file_path) == false) {
         return -1;
     }
-    result = region_info_process(p_file, end_pos, region_head, is_match_memory);
-    if (result == 0) {
-        *is_has_region = true;
+
+    const char *data = store->mapping.data;
+    size_t size      = store->mapping.size;
+    const struct record_store_header *header = (const struct record_store_header *)data;
+
+    if (size < sizeof(struct record_store_header)
+    ||  header->magic != magic
+    ||  header->version != RECORD_STORE_VERSION
+    ||  header->file_size != size
+    ||  record_section_check(size, header->entry_offset,  header->entry_qty,   sizeof(struct record_store_entry)) == false
+    ||  record_section_check(size, header->string_offset, header->string_size, sizeof(char)) == false
+    ||  header->string_size == 0
+    ||  data[header->string_offset + header->string_size - 1] != '\0')
+    {
+        record_store_close(store);
+        return -2;
     }
 
-    return result;
+    const struct record_store_entry *entry = (const struct record_store_entry *)(data + header->entry_offset);
+    for (uint32_t i = 0; i < header->entry_qty; i++)
+    {
+        if (entry[i].key >= header->string_size
+        ||  record_section_check(size, entry[i].offset, entry[i].size, sizeof(char)) == false)
+        {
+            record_store_close(store);
+            return -2;
+        }
+    }
+
+    if (hash_table_init(&store->index, header->entry_qty, false) == false)
+    {
+        record_store_close(store);
+        return -3;
+    }
+    for (uint32_t i = 0; i < header->entry_qty; i++)
+    {
+        if (hash_table_add(&store->index, data + header->string_offset + entry[i].key, (void *)&entry[i]) == false)
+        {
+            record_store_close(store);
+            return -3;
+        }
+    }
+
+    store->header = header;
+    store->entry  = entry;
+    store->string = data + header->string_offset;
+
+    return 0;
 }
 
 
 /**
- * @brief  object 信息打印处理
+ * @brief  按 key 查找条目的内容
+ * @note   只读访问，可在多个线程中同时调用
+ * @param  store: 记录存储
+ * @param  key:   条目的 key
+ * @param  size:  [out] 内容的大小
+ * @retval NULL: 不存在 | 条目的内容
+ */
+const char * record_store_data(const struct record_store *store, 
+                               const char *key, 
+                               size_t *size)
+{
+    if (store == NULL || store->header == NULL) {
+        return NULL;
+    }
+
+    const struct record_store_entry *entry = hash_table_find(&store->index, key);
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    *size = entry->size;
+    return store->mapping.data + entry->offset;
+}
+
+
+/**
+ * @brief  计算条目内容的哈希值
  * @note   
- * @param  object_head:     object 文件链表头
- * @param  max_path_len:    最大路径长度
- * @param  is_has_record:   是否有记录文件
- * @retval None
+ * @param  store: 记录存储
+ * @param  key:   条目的 key
+ * @retval 0: 不存在 | 哈希值
  */
-void object_print_process(struct object_info *object_head,
-                          size_t max_path_len, 
-                          bool is_has_record)
+uint64_t record_store_hash(const struct record_store *store, const char *key)
 {
-    if ((max_path_len + 2) < strlen(STR_FILE)) {
-        max_path_len = strlen(STR_FILE);
+    size_t size = 0;
+    const char *data = record_store_data(store, key, &size);
+    if (data == NULL) {
+        return 0;
     }
 
-    size_t len = max_path_len + 2 - strlen(STR_FILE);
-    if (_is_display_path) {
-        len += strlen("():");
+    return hash_data(data, size);
+}
+
+
+/**
+ * @brief  按 key 查找记录
+ * @note   只读访问，可在多个线程中同时调用
+ * @param  store:  记录存储
+ * @param  key:    记录的 key
+ * @param  record: [out] 记录
+ * @retval 0: 正常 | -1: 不存在 | -2: 格式或版本不符
+ */
+int record_store_find(const struct record_store *store, 
+                      const char *key, 
+                      struct record_view *record)
+{
+    memset(record, 0, sizeof(struct record_view));
+
+    size_t size = 0;
+    const char *data = record_store_data(store, key, &size);
+    if (data == NULL) {
+        return -1;
     }
 
-    size_t left_space  = len / 2;
-    size_t right_space = left_space;
-    if (len % 2) {
-        left_space += 1;
-    } 
+    return record_view_open(record, data, size);
+}
 
-    snprintf(_line_text, sizeof(_line_text), 
-             "%*s%s%*s|         RAM (byte)       |       FLASH (byte)       |\n", 
-             left_space, " ", STR_FILE, right_space, " ");
 
-    len = strnlen_s(_line_text, sizeof(_line_text));
-    char *line = (char *)malloc(len);
-    size_t i = 0;
-    for (; i < len - 1; i++) {
-        line[i] = '-';
+/**
+ * @brief  保存记录存储文件
+ * @note   本次的条目替换同 key 的旧条目，其余旧条目原样保留。内容为空的条目不保存。
+ *         多个进程可能同时保存同一个文件，加锁后重新打开文件，以其他进程保存后的内容为准
+ * @param  store:     上次的记录存储，保存后被关闭
+ * @param  file_path: 记录存储文件的绝对路径
+ * @param  magic:     文件的 magic，区分记录文件与分析缓存文件
+ * @param  items:     本次的条目列表
+ * @param  item_qty:  条目数量
+ * @retval 0: 正常 | -4: 文件被占用无法替换 | -5: 等待其他进程保存超时 | -x: 错误
+ */
+int record_store_save(struct record_store *store, 
+                      const char *file_path, 
+                      uint32_t magic, 
+                      const struct record_store_item *items, 
+                      size_t item_qty)
+{
+    bool is_has_item = false;
+    for (size_t i = 0; i < item_qty; i++) {
+        is_has_item |= (items[i].image->size != 0);
     }
-    line[i] = '\0';
-    log_print(_log_file, "%s\n", line);
-    log_print(_log_file, "%s", _line_text);
-    log_print(_log_file, "%s\n", line);
-    
-    for (struct object_info *obj_info = object_head; 
-         obj_info != NULL; 
-         obj_info = obj_info->next)
+
+    record_store_close(store);
+    if (is_has_item == false) {
+        return 0;
+    }
+
+    HANDLE lock = record_store_lock(file_path);
+    if (lock == INVALID_HANDLE_VALUE) {
+        return -5;
+    }
+
+    struct record_store current;
+    record_store_open(&current, file_path, magic);
+
+    int result = record_store_rewrite(&current, file_path, magic, items, item_qty);
+
+    CloseHandle(lock);
+    return result;
+}
+
+
+/**
+ * @brief  获取记录存储文件的进程间锁
+ * @note   以独占方式打开同目录下的 .lock 文件，关闭句柄即释放锁，文件随之删除。构建历史文件同样使用。
+ *         被其他进程占用时每隔 10 ms 重试，超过 RECORD_STORE_LOCK_TIMEOUT 时失败
+ * @param  file_path: 记录存储文件的绝对路径
+ * @retval INVALID_HANDLE_VALUE: 失败 | 锁的句柄
+ */
+HANDLE record_store_lock(const char *file_path)
+{
+    size_t lock_path_size = strlen(file_path) + sizeof(".lock");
+    char *lock_path = (char *)malloc(lock_path_size);
+    if (lock_path == NULL) {
+        return INVALID_HANDLE_VALUE;
+    }
+    snprintf(lock_path, lock_path_size, "%s.lock", file_path);
+
+    HANDLE lock = INVALID_HANDLE_VALUE;
+    for (uint32_t wait = 0; wait <= RECORD_STORE_LOCK_TIMEOUT; wait += 10)
     {
-        if (obj_info->path == NULL) {
-            continue;
+        lock = CreateFile(lock_path, 
+                          GENERIC_WRITE, 
+                          0, 
+                          NULL, 
+                          OPEN_ALWAYS, 
+                          FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, 
+                          NULL);
+        if (lock != INVALID_HANDLE_VALUE) {
+            break;
         }
+        Sleep(10);
+    }
 
-        char *path        = obj_info->path;
-        char ram_text[MAX_PRJ_NAME_SIZE]   = {0};
-        char flash_text[MAX_PRJ_NAME_SIZE] = {0};
-        size_t path_len   = strnlen_s(obj_info->path, MAX_PATH);
-        size_t path_space = max_path_len - path_len + 1;
-        uint32_t ram      = obj_info->rw_data + obj_info->zi_data;
-        uint32_t flash    = obj_info->code + obj_info->ro_data + obj_info->rw_data;
+    free(lock_path);
+    return lock;
+}
 
-//        if (obj_info->path == NULL || _is_display_path == false) 
-        if (_is_display_path == false) 
-        {
-            path = obj_info->name;
-            if (path == NULL) {
-                path = "UNKNOWN";
-            }
-            path_len   = strnlen_s(path, MAX_PATH);
-            path_space = max_path_len - path_len + 1;
+
+/**
+ * @brief  重写记录存储文件
+ * @note   本次的条目替换同 key 的旧条目，其余旧条目原样保留，失效的内容被移除。内容为空的条目不保存。
+ *         生成新的内容后关闭旧的映射，被映射的文件无法被替换。先写入临时文件再替换，写入中断时不会破坏原文件
+ * @param  store:     当前的记录存储，重写后被关闭
+ * @param  file_path: 记录存储文件的绝对路径
+ * @param  magic:     文件的 magic，区分记录文件与分析缓存文件
+ * @param  items:     本次的条目列表
+ * @param  item_qty:  条目数量
+ * @retval 0: 正常 | -x: 错误
+ */
+int record_store_rewrite(struct record_store *store, 
+                         const char *file_path, 
+                         uint32_t magic, 
+                         const struct record_store_item *items, 
+                         size_t item_qty)
+{
+    int result = 0;
+    struct hash_table item_index = {0};
+    struct text_buffer string    = {0};
+    struct text_buffer image     = {0};
+    struct record_store_entry *entry = NULL;
+    const struct record_store_item **source_item = NULL;    /* 各条目的来源，为 NULL 时来自旧条目 */
+    bool *is_saved = NULL;
+
+    size_t old_qty = store->header ? store->header->entry_qty : 0;
+    size_t new_qty = 0;
+    for (size_t i = 0; i < item_qty; i++) 
+    {
+        if (items[i].image->size) {
+            new_qty++;
         }
+    }
+    if (new_qty == 0) 
+    {
+        record_store_close(store);
+        return 0;
+    }
 
-        if (is_has_record)
+    entry       = (struct record_store_entry *)calloc(old_qty + new_qty, sizeof(struct record_store_entry));
+    source_item = (const struct record_store_item **)calloc(old_qty + new_qty, sizeof(struct record_store_item *));
+    is_saved    = (bool *)calloc(item_qty, sizeof(bool));
+    if (entry == NULL 
+    ||  source_item == NULL 
+    ||  is_saved == NULL 
+    ||  hash_table_init(&item_index, new_qty, false) == false)
+    {
+        result = -1;
+        goto __exit;
+    }
+
+    for (size_t i = 0; i < item_qty; i++)
+    {
+        if (items[i].image->size 
+        &&  hash_table_add(&item_index, items[i].key, (void *)&items[i]) == false)
         {
-            if (obj_info->old_object == NULL)
-            {
-                strncpy_s(ram_text,   sizeof(ram_text),   "[NEW]     ", 10);
-                strncpy_s(flash_text, sizeof(flash_text), "[NEW]     ", 10);
-            }
-            else
-            {
-                char ram_sign;
-                char flash_sign;
-                uint32_t old_ram      = obj_info->old_object->rw_data + obj_info->old_object->zi_data;
-                uint32_t old_flash    = obj_info->old_object->code + obj_info->old_object->ro_data + obj_info->old_object->rw_data;
-                uint32_t ram_increm   = 0;
-                uint32_t flash_increm = 0;
+            result = -1;
+            goto __exit;
+        }
+    }
 
-                if (ram < old_ram)
-                {
-                    ram_increm = old_ram - ram;
+    /* 确定各条目的来源，旧条目保持原有顺序，新增的条目按顺序追加 */
+    const struct record_store_entry *old_entry = store->entry;
+    size_t entry_qty = 0;
+    for (size_t i = 0; i < old_qty; i++)
+    {
+        const struct record_store_item *item = hash_table_find(&item_index, store->string + old_entry[i].key);
+        if (item) {
+            is_saved[item - items] = true;
+        }
+        source_item[entry_qty] = item;
+        entry[entry_qty].key   = old_entry[i].key;
+        entry[entry_qty].size  = item ? (uint32_t)item->image->size : old_entry[i].size;
+        entry_qty++;
+    }
+    for (size_t i = 0; i < item_qty; i++)
+    {
+        /* 同 key 的条目只保存最后一个 */
+        if (items[i].image->size == 0 
+        ||  is_saved[i]
+        ||  hash_table_find(&item_index, items[i].key) != &items[i]) 
+        {
+            continue;
+        }
+        is_saved[i] = true;
+        source_item[entry_qty] = &items[i];
+        entry[entry_qty].size  = (uint32_t)items[i].image->size;
+        entry_qty++;
+    }
+
+    /* 字符串表 */
+    bool is_ok = true;
+    for (size_t i = 0; i < entry_qty && is_ok; i++)
+    {
+        const char *key = source_item[i] ? source_item[i]->key : store->string + entry[i].key;
+        is_ok = record_string_add(&string, key, &entry[i].key);
+    }
+
+    /* 布局：文件头 | 记录索引 | 字符串表 | 各个记录，记录 4 字节对齐 */
+    struct record_store_header header = {
+        .magic         = magic,
+        .version       = RECORD_STORE_VERSION,
+        .entry_qty     = (uint32_t)entry_qty,
+        .entry_offset  = sizeof(struct record_store_header),
+        .string_size   = (uint32_t)string.size,
+    };
+    header.string_offset = header.entry_offset + header.entry_qty * sizeof(struct record_store_entry);
+
+    uint32_t offset = (header.string_offset + header.string_size + 3) & ~3u;
+    for (size_t i = 0; i < entry_qty; i++)
+    {
+        entry[i].offset = offset;
+        offset = (offset + entry[i].size + 3) & ~3u;
+    }
+    header.file_size = offset;
+
+    static const char padding[4] = {0};
+    is_ok = is_ok 
+         && text_buffer_reserve(&image, header.file_size)
+         && text_buffer_append(&image, (const char *)&header, sizeof(header))
+         && text_buffer_append(&image, (const char *)entry, entry_qty * sizeof(struct record_store_entry))
+         && text_buffer_append(&image, string.data, string.size);
+
+    for (size_t i = 0; i < entry_qty && is_ok; i++)
+    {
+        const char *data = source_item[i] ? source_item[i]->image->data : store->mapping.data + old_entry[i].offset;
+        is_ok = text_buffer_append(&image, padding, entry[i].offset - image.size)
+             && text_buffer_append(&image, data, entry[i].size);
+    }
+    is_ok = is_ok && text_buffer_append(&image, padding, header.file_size - image.size);
+
+    if (is_ok == false)
+    {
+        result = -1;
+        goto __exit;
+    }
+
+    record_store_close(store);
+    result = record_file_write(file_path, &image);
+
+__exit:
+    record_store_close(store);
+    hash_table_free(&item_index);
+    text_buffer_free(&string);
+    text_buffer_free(&image);
+    free(entry);
+    free(source_item);
+    free(is_saved);
+    return result;
+}
+
+
+/**
+ * @brief  关闭记录存储文件
+ * @note   
+ * @param  store: 记录存储
+ * @retval None
+ */
+void record_store_close(struct record_store *store)
+{
+    hash_table_free(&store->index);
+    if (store->mapping.data) {
+        file_mapping_close(&store->mapping);
+    }
+    memset(store, 0, sizeof(struct record_store));
+}
+
+
+/**
+ * @brief  生成记录的 key
+ * @note   
+ * @param  out_key:      [out] 记录的 key
+ * @param  out_key_size: key 的大小
+ * @param  prj_name:     keil 工程名
+ * @param  target_name:  target 名
+ * @retval None
+ */
+void record_key_build(char *out_key, 
+                      size_t out_key_size, 
+                      const char *prj_name, 
+                      const char *target_name)
+{
+    snprintf(out_key, out_key_size, "%s" RECORD_KEY_SEPARATOR "%s", prj_name, target_name);
+}
+
+
+/**
+ * @brief  打开构建历史文件
+ * @note   逐个校验 frame，建立名称表并按 key 建立索引。遇到无效的 frame 时停止，
+ *         其后的内容视为写入中断的残留
+ * @param  history:   [out] 构建历史
+ * @param  file_path: 构建历史文件的绝对路径
+ * @retval 0: 正常 | -1: 无法打开 | -2: 格式或版本不符 | -3: 内存不足
+ */
+int history_open(struct history *history, const char *file_path)
+{
+    memset(history, 0, sizeof(struct history));
+
+    if (file_mapping_open(&history->mapping, file_path) == false) {
+        return -1;
+    }
+
+    const char *data = history->mapping.data;
+    size_t size      = history->mapping.size;
+    const struct history_header *header = (const struct history_header *)data;
+
+    if (size < sizeof(struct history_header)
+    ||  header->magic != HISTORY_MAGIC
+    ||  header->version != HISTORY_VERSION)
+    {
+        history_close(history);
+        return -2;
+    }
+
+    if (history_index_init(history) == false)
+    {
+        history_close(history);
+        return -3;
+    }
+
+    /* 第一遍校验 frame，建立名称表，并统计各 key 的构建数量 */
+    size_t offset = sizeof(struct history_header);
+    while (size - offset >= sizeof(struct history_frame_header))
+    {
+        /* frame 没有对齐要求，复制后访问 */
+        struct history_frame_header frame;
+        memcpy(&frame, data + offset, sizeof(frame));
+
+        if (frame.magic != HISTORY_FRAME_MAGIC
+        ||  frame.seq != history->frame_qty + 1
+        ||  frame.size < sizeof(struct history_frame_header)
+        ||  frame.size > size - offset)
+        {
+            break;
+        }
+
+        const uint8_t *frame_data = (const uint8_t *)data + offset;
+        int res = history_frame_index(history, 
+                                      &frame, 
+                                      frame_data + sizeof(struct history_frame_header), 
+                                      frame_data + frame.size);
+        if (res == -3)
+        {
+            history_close(history);
+            return -3;
+        }
+        if (res != 0) {
+            break;
+        }
+
+        history->frame_qty++;
+        offset += frame.size;
+    }
+    history->valid_size = offset;
+
+    /* 第二遍按构建顺序填充各 key 的 frame 列表 */
+    for (uint32_t i = 0; i < history->frame_qty; i++)
+    {
+        struct history_series *series = history->frame[i].series;
+
+        if (series->frame == NULL)
+        {
+            series->frame = (const struct history_frame **)arena_alloc(&history->arena, series->qty * sizeof(struct history_frame *));
+            if (series->frame == NULL)
+            {
+                history_close(history);
+                return -3;
+            }
+            series->qty = 0;
+        }
+        series->frame[series->qty++] = &history->frame[i];
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief  关闭构建历史文件
+ * @note   
+ * @param  history: 构建历史
+ * @retval None
+ */
+void history_close(struct history *history)
+{
+    hash_table_free(&history->name_index);
+    hash_table_free(&history->key_index);
+    arena_free(&history->arena);
+    free(history->frame);
+    free((void *)history->name);
+    if (history->mapping.data) {
+        file_mapping_close(&history->mapping);
+    }
+    memset(history, 0, sizeof(struct history));
+}
+
+
+/**
+ * @brief  将无效或版本不符的构建历史文件改名保留
+ * @note   改名为 "<文件名>.old"，覆盖上次保留的文件
+ * @param  file_path: 构建历史文件的绝对路径
+ * @retval true: 成功 | false: 失败
+ */
+bool history_file_backup(const char *file_path)
+{
+    size_t old_path_size = strlen(file_path) + sizeof(".old");
+    char *old_path = (char *)malloc(old_path_size);
+    if (old_path == NULL) {
+        return false;
+    }
+    snprintf(old_path, old_path_size, "%s.old", file_path);
+
+    BOOL is_moved = MoveFileEx(file_path, old_path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+
+    free(old_path);
+    return is_moved != FALSE;
+}
+
+
+/**
+ * @brief  初始化构建历史的名称及 key 索引
+ * @note   
+ * @param  history: 构建历史
+ * @retval true: 成功 | false: 内存不足
+ */
+bool history_index_init(struct history *history)
+{
+    return hash_table_init(&history->name_index, 256, true)
+        && hash_table_init(&history->key_index, 16, true);
+}
+
+
+/**
+ * @brief  校验 frame 的名称段并加入索引
+ * @note   名称全部校验通过后才加入名称表，以免写入中断的 frame 改变名称的编号。
+ *         其余内容在还原构建时校验
+ * @param  history: 构建历史
+ * @param  header:  frame 头
+ * @param  payload: frame 头之后的内容
+ * @param  end:     frame 的结束位置
+ * @retval 0: 正常 | -2: 内容无效 | -3: 内存不足
+ */
+int history_frame_index(struct history *history, 
+                        const struct history_frame_header *header, 
+                        const uint8_t *payload, 
+                        const uint8_t *end)
+{
+    const uint8_t *data = payload;
+    uint32_t new_qty = 0;
+    uint32_t len     = 0;
+    uint32_t key     = 0;
+
+    if (varint_read(&data, end, &new_qty) == false) {
+        return -2;
+    }
+    for (uint32_t i = 0; i < new_qty; i++)
+    {
+        if (varint_read(&data, end, &len) == false
+        ||  len > (size_t)(end - data)) 
+        {
+            return -2;
+        }
+        data += len;
+    }
+    if (varint_read(&data, end, &key) == false
+    ||  key >= history->name_qty + new_qty) 
+    {
+        return -2;
+    }
+
+    data = payload;
+    varint_read(&data, end, &new_qty);
+    for (uint32_t i = 0; i < new_qty; i++)
+    {
+        varint_read(&data, end, &len);
+        if (history_name_add(history, (const char *)data, len) == HISTORY_NAME_NONE) {
+            return -3;
+        }
+        data += len;
+    }
+    varint_read(&data, end, &key);
+
+    const char *key_name = history->name[key];
+    struct history_series *series = hash_table_find(&history->key_index, key_name);
+    if (series == NULL)
+    {
+        series = (struct history_series *)arena_alloc(&history->arena, sizeof(struct history_series));
+        if (series == NULL || hash_table_add(&history->key_index, key_name, series) == false) {
+            return -3;
+        }
+        series->key   = key_name;
+        series->frame = NULL;
+        series->qty   = 0;
+    }
+    series->qty++;
+
+    if (history->frame_qty == history->frame_capacity)
+    {
+        size_t capacity = history->frame_capacity ? history->frame_capacity * 2 : 256;
+        struct history_frame *frame = (struct history_frame *)realloc(history->frame, capacity * sizeof(struct history_frame));
+        if (frame == NULL) {
+            return -3;
+        }
+        history->frame          = frame;
+        history->frame_capacity = capacity;
+    }
+
+    struct history_frame *frame = &history->frame[history->frame_qty];
+    frame->payload = data;
+    frame->end     = end;
+    frame->time    = header->time;
+    frame->flags   = header->flags;
+    frame->series  = series;
+
+    return 0;
+}
+
+
+/**
+ * @brief  向名称表添加名称
+ * @note   名称复制到 arena 中，序号为添加的顺序
+ * @param  history: 构建历史
+ * @param  str:     名称，不要求以 '\0' 结尾
+ * @param  len:     名称的长度
+ * @retval HISTORY_NAME_NONE: 内存不足 | 名称的序号
+ */
+uint32_t history_name_add(struct history *history, const char *str, size_t len)
+{
+    if (history->name_qty == history->name_capacity)
+    {
+        size_t capacity = history->name_capacity ? history->name_capacity * 2 : 256;
+        const char **name = (const char **)realloc((void *)history->name, capacity * sizeof(char *));
+        if (name == NULL) {
+            return HISTORY_NAME_NONE;
+        }
+        history->name          = name;
+        history->name_capacity = capacity;
+    }
+
+    char *copy = (char *)arena_alloc(&history->arena, len + 1);
+    if (copy == NULL) {
+        return HISTORY_NAME_NONE;
+    }
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+
+    uint32_t id = (uint32_t)history->name_qty;
+    if (hash_table_add(&history->name_index, copy, (void *)(uintptr_t)(id + 1)) == false) {
+        return HISTORY_NAME_NONE;
+    }
+    history->name[history->name_qty++] = copy;
+
+    return id;
+}
+
+
+/**
+ * @brief  查找名称的序号
+ * @note   忽略大小写
+ * @param  history: 构建历史
+ * @param  str:     名称
+ * @retval HISTORY_NAME_NONE: 不存在 | 名称的序号
+ */
+uint32_t history_name_find(const struct history *history, const char *str)
+{
+    uintptr_t value = (uintptr_t)hash_table_find(&history->name_index, str);
+    if (value == 0) {
+        return HISTORY_NAME_NONE;
+    }
+
+    return (uint32_t)(value - 1);
+}
+
+
+/**
+ * @brief  获取名称的序号，不存在时添加
+ * @note   新增的名称同时编码到 name 中，随 frame 一同写入
+ * @param  history: 构建历史
+ * @param  str:     名称
+ * @param  name:    [out] 新增名称的编码
+ * @param  new_qty: [out] 新增名称的数量
+ * @retval HISTORY_NAME_NONE: 内存不足 | 名称的序号
+ */
+uint32_t history_name_intern(struct history *history, 
+                             const char *str, 
+                             struct text_buffer *name, 
+                             uint32_t *new_qty)
+{
+    uint32_t id = history_name_find(history, str);
+    if (id != HISTORY_NAME_NONE) {
+        return id;
+    }
+
+    size_t len = strlen(str);
+    if (varint_write(name, (uint32_t)len) == false
+    ||  text_buffer_append(name, str, len) == false) 
+    {
+        return HISTORY_NAME_NONE;
+    }
+
+    id = history_name_add(history, str, len);
+    if (id != HISTORY_NAME_NONE) {
+        (*new_qty)++;
+    }
+
+    return id;
+}
+
+
+/**
+ * @brief  将 frame 应用到构建快照上
+ * @note   keyframe 替换全部 object，其余 frame 在上次构建的基础上修改。
+ *         不包含 object 信息的 frame 清空 object
+ * @param  history:  构建历史
+ * @param  frame:    单次构建的 frame
+ * @param  snapshot: [in/out] 上次构建的快照，应用后为本次构建的快照
+ * @retval true: 成功 | false: 内容无效或内存不足
+ */
+bool history_snapshot_apply(const struct history *history, 
+                            const struct history_frame *frame, 
+                            struct history_snapshot *snapshot)
+{
+    const uint8_t *data = frame->payload;
+    const uint8_t *end  = frame->end;
+    uint32_t qty = 0;
+
+    if (snapshot->object_capacity < history->name_qty)
+    {
+        struct record_object *object = (struct record_object *)realloc(snapshot->object, history->name_qty * sizeof(struct record_object));
+        if (object == NULL) {
+            return false;
+        }
+        for (size_t i = snapshot->object_capacity; i < history->name_qty; i++) {
+            object[i].name = HISTORY_NAME_NONE;
+        }
+        snapshot->object          = object;
+        snapshot->object_capacity = history->name_qty;
+    }
+
+    if (varint_read(&data, end, &qty) == false) {
+        return false;
+    }
+    if (snapshot->region_capacity < qty)
+    {
+        struct record_exec_region *region = (struct record_exec_region *)realloc(snapshot->region, qty * sizeof(struct record_exec_region));
+        if (region == NULL) {
+            return false;
+        }
+        snapshot->region          = region;
+        snapshot->region_capacity = qty;
+    }
+    for (uint32_t i = 0; i < qty; i++)
+    {
+        struct record_exec_region *region = &snapshot->region[i];
+        if (varint_read(&data, end, &region->name) == false
+        ||  varint_read(&data, end, &region->base_addr) == false
+        ||  varint_read(&data, end, &region->size) == false
+        ||  varint_read(&data, end, &region->used_size) == false
+        ||  region->name >= history->name_qty)
+        {
+            return false;
+        }
+    }
+    snapshot->region_qty = qty;
+
+    bool is_keyframe = (frame->flags & HISTORY_FLAG_KEYFRAME) != 0;
+    if ((frame->flags & HISTORY_FLAG_OBJECT) == 0 || is_keyframe)
+    {
+        for (size_t i = 0; i < snapshot->object_capacity; i++) {
+            snapshot->object[i].name = HISTORY_NAME_NONE;
+        }
+        snapshot->is_has_object = false;
+
+        if ((frame->flags & HISTORY_FLAG_OBJECT) == 0) {
+            return true;
+        }
+    }
+    else if (snapshot->is_has_object == false) {
+        return false;
+    }
+
+    /* 依次为删除的 object 及变化的 object，keyframe 只有后者 */
+    uint32_t name = 0;
+    if (is_keyframe == false)
+    {
+        if (varint_read(&data, end, &qty) == false) {
+            return false;
+        }
+        for (uint32_t i = 0; i < qty; i++)
+        {
+            uint32_t delta = 0;
+            if (varint_read(&data, end, &delta) == false
+            ||  delta >= history->name_qty - name)
+            {
+                return false;
+            }
+            name += delta;
+            snapshot->object[name].name = HISTORY_NAME_NONE;
+        }
+    }
+
+    if (varint_read(&data, end, &qty) == false) {
+        return false;
+    }
+    name = 0;
+    for (uint32_t i = 0; i < qty; i++)
+    {
+        struct record_object object;
+        uint32_t delta = 0;
+        if (varint_read(&data, end, &delta) == false
+        ||  delta >= history->name_qty - name
+        ||  varint_read(&data, end, &object.code) == false
+        ||  varint_read(&data, end, &object.ro_data) == false
+        ||  varint_read(&data, end, &object.rw_data) == false
+        ||  varint_read(&data, end, &object.zi_data) == false)
+        {
+            return false;
+        }
+        name += delta;
+        object.name = name;
+        snapshot->object[name] = object;
+    }
+    snapshot->is_has_object = true;
+
+    return true;
+}
+
+
+/**
+ * @brief  还原单次构建的快照
+ * @note   从之前最近的 keyframe 开始依次应用 frame
+ * @param  history:  构建历史
+ * @param  series:   工程及 target 的全部构建
+ * @param  index:    构建在 series 中的序号
+ * @param  snapshot: [out] 构建快照，使用后由 history_snapshot_free 释放
+ * @retval true: 成功 | false: 内容无效或内存不足
+ */
+bool history_snapshot_load(const struct history *history, 
+                           const struct history_series *series, 
+                           size_t index, 
+                           struct history_snapshot *snapshot)
+{
+    size_t start = index;
+    if (series->frame[index]->flags & HISTORY_FLAG_OBJECT)
+    {
+        while (start > 0 && (series->frame[start]->flags & HISTORY_FLAG_KEYFRAME) == 0) {
+            start--;
+        }
+    }
+
+    for (size_t i = start; i <= index; i++)
+    {
+        if (history_snapshot_apply(history, series->frame[i], snapshot) == false) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief  释放构建快照
+ * @note   
+ * @param  snapshot: 构建快照
+ * @retval None
+ */
+void history_snapshot_free(struct history_snapshot *snapshot)
+{
+    free(snapshot->object);
+    free(snapshot->region);
+    memset(snapshot, 0, sizeof(struct history_snapshot));
+}
+
+
+/**
+ * @brief  生成本次构建的信息
+ * @note   追加到构建历史时编码为 frame。object_list 为 NULL 时表示本次没有 object 信息
+ * @param  build:       [out] 本次构建的信息
+ * @param  key:         工程及 target 的 key
+ * @param  time:        构建时间
+ * @param  object_list: 本次的 object 链表
+ * @param  region_list: 本次的 region 链表
+ * @retval true: 成功 | false: 内存不足
+ */
+bool history_build_create(struct text_buffer *build,
+                          const char *key,
+                          int64_t time,
+                          const struct object_list *object_list,
+                          const struct region_list *region_list)
+{
+    struct history_build_header header = {
+        .time = time,
+    };
+    struct text_buffer string = {0};
+    bool is_ok = true;
+
+    if (object_list)
+    {
+        header.flags     |= HISTORY_FLAG_OBJECT;
+        header.object_qty = object_list->size;
+    }
+
+    for (struct load_region *l_region = region_list->head; l_region != NULL; l_region = l_region->next)
+    {
+        for (struct exec_region *e_region = l_region->exec_region; e_region != NULL; e_region = e_region->next) {
+            header.region_qty++;
+        }
+    }
+
+    header.region_offset = sizeof(struct history_build_header);
+    header.object_offset = header.region_offset + header.region_qty * sizeof(struct record_exec_region);
+    header.string_offset = header.object_offset + header.object_qty * sizeof(struct record_object);
+
+    build->size = 0;
+    is_ok = record_string_add(&string, key, &header.key)
+         && text_buffer_reserve(build, header.string_offset)
+         && text_buffer_append(build, (const char *)&header, sizeof(header));
+
+    for (struct load_region *l_region = region_list->head; 
+         l_region != NULL && is_ok; 
+         l_region = l_region->next)
+    {
+        for (struct exec_region *e_region = l_region->exec_region; 
+             e_region != NULL && is_ok; 
+             e_region = e_region->next)
+        {
+            struct record_exec_region region = {
+                .base_addr = e_region->base_addr,
+                .size      = e_region->size,
+                .used_size = e_region->used_size,
+            };
+            is_ok = record_string_add(&string, e_region->name, &region.name)
+                 && text_buffer_append(build, (const char *)&region, sizeof(region));
+        }
+    }
+
+    for (struct object_info *object_temp = object_list ? object_list->head : NULL; 
+         object_temp != NULL && is_ok; 
+         object_temp = object_temp->next)
+    {
+        struct record_object object = {
+            .code    = object_temp->code,
+            .ro_data = object_temp->ro_data,
+            .rw_data = object_temp->rw_data,
+            .zi_data = object_temp->zi_data,
+        };
+        is_ok = record_string_add(&string, object_temp->name, &object.name)
+             && text_buffer_append(build, (const char *)&object, sizeof(object));
+    }
+
+    if (is_ok)
+    {
+        header.string_size = (uint32_t)string.size;
+        memcpy(build->data, &header, sizeof(header));
+        is_ok = text_buffer_append(build, string.data, string.size);
+    }
+
+    text_buffer_free(&string);
+    return is_ok;
+}
+
+
+/**
+ * @brief  按名称序号比较 object
+ * @note   供 qsort 使用
+ * @param  a: struct record_object * 
+ * @param  b: struct record_object * 
+ * @retval 比较结果
+ */
+int history_row_compare(const void *a, const void *b)
+{
+    const struct record_object *object_a = (const struct record_object *)a;
+    const struct record_object *object_b = (const struct record_object *)b;
+
+    if (object_a->name < object_b->name) {
+        return -1;
+    }
+    return object_a->name > object_b->name;
+}
+
+
+/**
+ * @brief  编码单个 object
+ * @note   名称序号记为与前一个 object 的差值
+ * @param  buffer:    编码输出
+ * @param  object:    object 的大小信息，name 为名称序号
+ * @param  last_name: [in/out] 前一个 object 的名称序号
+ * @retval true: 成功 | false: 内存不足
+ */
+bool history_row_write(struct text_buffer *buffer, 
+                       const struct record_object *object, 
+                       uint32_t *last_name)
+{
+    bool is_ok = varint_write(buffer, object->name - *last_name)
+              && varint_write(buffer, object->code)
+              && varint_write(buffer, object->ro_data)
+              && varint_write(buffer, object->rw_data)
+              && varint_write(buffer, object->zi_data);
+
+    *last_name = object->name;
+    return is_ok;
+}
+
+
+/**
+ * @brief  将本次构建的信息编码为 frame
+ * @note   同一 key 的上次构建包含 object 信息，且距上个 keyframe 不足 HISTORY_KEYFRAME_INTERVAL 次构建时，
+ *         仅编码与上次构建的差异。新增的名称加入名称表，编号与写入文件的顺序一致
+ * @param  history:    构建历史
+ * @param  build_data: history_build_create 生成的本次构建信息
+ * @param  seq:        frame 的序号
+ * @param  frame:      [out] 编码后的 frame，追加到原有内容之后
+ * @retval true: 成功 | false: 内存不足
+ */
+bool history_frame_encode(struct history *history, 
+                          const char *build_data, 
+                          uint32_t seq, 
+                          struct text_buffer *frame)
+{
+    const struct history_build_header *build = (const struct history_build_header *)build_data;
+    const struct record_exec_region *region   = (const struct record_exec_region *)(build_data + build->region_offset);
+    const struct record_object *object        = (const struct record_object *)(build_data + build->object_offset);
+    const char *string = build_data + build->string_offset;
+
+    struct history_frame_header header = {
+        .magic = HISTORY_FRAME_MAGIC,
+        .seq   = seq,
+        .flags = build->flags,
+        .time  = build->time,
+    };
+    struct text_buffer name    = {0};
+    struct text_buffer payload = {0};
+    struct history_snapshot last = {0};
+    struct record_object *row = NULL;
+    size_t row_qty   = 0;
+    uint32_t new_qty = 0;
+    bool is_ok = true;
+
+    uint32_t key = history_name_intern(history, string + build->key, &name, &new_qty);
+    is_ok = key != HISTORY_NAME_NONE
+         && varint_write(&payload, key)
+         && varint_write(&payload, build->region_qty);
+
+    for (uint32_t i = 0; i < build->region_qty && is_ok; i++)
+    {
+        uint32_t id = history_name_intern(history, string + region[i].name, &name, &new_qty);
+        is_ok = id != HISTORY_NAME_NONE
+             && varint_write(&payload, id)
+             && varint_write(&payload, region[i].base_addr)
+             && varint_write(&payload, region[i].size)
+             && varint_write(&payload, region[i].used_size);
+    }
+
+    if (is_ok && (build->flags & HISTORY_FLAG_OBJECT))
+    {
+        row = (struct record_object *)malloc((build->object_qty + 1) * sizeof(struct record_object));
+        is_ok = row != NULL;
+
+        for (uint32_t i = 0; i < build->object_qty && is_ok; i++)
+        {
+            row[i]      = object[i];
+            row[i].name = history_name_intern(history, string + object[i].name, &name, &new_qty);
+            is_ok = row[i].name != HISTORY_NAME_NONE;
+        }
+    }
+
+    if (is_ok && row)
+    {
+        /* 按名称序号排序，同名的 object 只保留一个 */
+        qsort(row, build->object_qty, sizeof(struct record_object), history_row_compare);
+        for (uint32_t i = 0; i < build->object_qty; i++)
+        {
+            if (row_qty == 0 || row[row_qty - 1].name != row[i].name) {
+                row[row_qty++] = row[i];
+            }
+        }
+
+        /* 上次构建距 keyframe 的构建数量，上次没有 object 信息时必须使用 keyframe */
+        const struct history_series *series = hash_table_find(&history->key_index, string + build->key);
+        size_t delta_qty = HISTORY_KEYFRAME_INTERVAL;
+        if (series && series->qty > 0)
+        {
+            for (size_t i = series->qty; i > 0; i--)
+            {
+                uint16_t flags = series->frame[i - 1]->flags;
+                if ((flags & HISTORY_FLAG_OBJECT) == 0) {
+                    break;
+                }
+                if (flags & HISTORY_FLAG_KEYFRAME)
+                {
+                    delta_qty = series->qty - i;
+                    break;
+                }
+            }
+        }
+
+        bool is_keyframe = delta_qty + 1 >= HISTORY_KEYFRAME_INTERVAL
+                        || history_snapshot_load(history, series, series->qty - 1, &last) == false
+                        || last.is_has_object == false;
+
+        uint32_t last_name = 0;
+        if (is_keyframe)
+        {
+            header.flags |= HISTORY_FLAG_KEYFRAME;
+            is_ok = varint_write(&payload, (uint32_t)row_qty);
+            for (size_t i = 0; i < row_qty && is_ok; i++) {
+                is_ok = history_row_write(&payload, &row[i], &last_name);
+            }
+        }
+        else
+        {
+            /* 与上次构建逐个名称序号比较，分别编码删除的及变化的 object */
+            struct text_buffer removed = {0};
+            struct text_buffer changed = {0};
+            uint32_t removed_qty  = 0;
+            uint32_t changed_qty  = 0;
+            uint32_t removed_name = 0;
+            size_t r = 0;
+
+            for (size_t id = 0; id < last.object_capacity && is_ok; id++)
+            {
+                const struct record_object *old_object = last.object[id].name != HISTORY_NAME_NONE ? &last.object[id] : NULL;
+                const struct record_object *new_object = NULL;
+                if (r < row_qty && row[r].name == id) {
+                    new_object = &row[r++];
+                }
+
+                if (old_object && new_object == NULL)
+                {
+                    is_ok = varint_write(&removed, (uint32_t)id - removed_name);
+                    removed_name = (uint32_t)id;
+                    removed_qty++;
+                }
+                else if (new_object 
+                     && (old_object == NULL 
+                     ||  old_object->code    != new_object->code
+                     ||  old_object->ro_data != new_object->ro_data
+                     ||  old_object->rw_data != new_object->rw_data
+                     ||  old_object->zi_data != new_object->zi_data))
+                {
+                    is_ok = history_row_write(&changed, new_object, &last_name);
+                    changed_qty++;
+                }
+            }
+
+            is_ok = is_ok
+                 && varint_write(&payload, removed_qty)
+                 && text_buffer_append(&payload, removed.data, removed.size)
+                 && varint_write(&payload, changed_qty)
+                 && text_buffer_append(&payload, changed.data, changed.size);
+
+            text_buffer_free(&removed);
+            text_buffer_free(&changed);
+        }
+    }
+
+    size_t start = frame->size;
+    if (is_ok)
+    {
+        is_ok = text_buffer_append(frame, (const char *)&header, sizeof(header))
+             && varint_write(frame, new_qty)
+             && text_buffer_append(frame, name.data, name.size)
+             && text_buffer_append(frame, payload.data, payload.size);
+    }
+    if (is_ok)
+    {
+        header.size = (uint32_t)(frame->size - start);
+        memcpy(frame->data + start, &header, sizeof(header));
+    }
+    else {
+        frame->size = start;
+    }
+
+    free(row);
+    history_snapshot_free(&last);
+    text_buffer_free(&name);
+    text_buffer_free(&payload);
+    return is_ok;
+}
+
+
+/**
+ * @brief  追加本次的构建历史
+ * @note   从有效内容之后开始写入，覆盖上次写入中断的残留。各任务的构建信息编码完成后关闭历史文件的映射再写入。
+ *         某个 frame 编码失败时不再编码其后的 frame，以免名称的编号与文件内容不一致。
+ *         调用者需从 history_open 起持有 record_store_lock，没有有效内容时新建文件，无效的文件需先改名保留
+ * @param  history:   构建历史，追加后被关闭
+ * @param  file_path: 构建历史文件的绝对路径
+ * @param  jobs:      分析任务列表，按顺序为各 frame 填写序号
+ * @param  job_qty:   任务数量
+ * @retval 0: 正常 | -x: 错误
+ */
+int history_append(struct history *history, 
+                   const char *file_path, 
+                   struct project_job *jobs, 
+                   size_t job_qty)
+{
+    struct text_buffer frames = {0};
+    int result = 0;
+
+    /* 历史文件无效时重建，名称从 0 开始编号 */
+    if (history->valid_size == 0)
+    {
+        history_close(history);
+        if (history_index_init(history) == false) {
+            result = -3;
+        }
+    }
+
+    uint32_t seq = history->frame_qty;
+    for (size_t i = 0; i < job_qty && result == 0; i++)
+    {
+        if (jobs[i].history_build.size == 0) {
+            continue;
+        }
+
+        if (history_frame_encode(history, jobs[i].history_build.data, seq + 1, &frames) == false) {
+            result = -3;
+        } else {
+            seq++;
+        }
+    }
+
+    size_t valid_size = history->valid_size;
+    history_close(history);
+
+    if (frames.size == 0)
+    {
+        text_buffer_free(&frames);
+        return result;
+    }
+
+    FILE *p_file = fopen(file_path, (valid_size == 0) ? "wb" : "r+b");
+    if (p_file == NULL)
+    {
+        text_buffer_free(&frames);
+        return -1;
+    }
+
+    bool is_ok = true;
+    if (valid_size == 0)
+    {
+        struct history_header header = {
+            .magic   = HISTORY_MAGIC,
+            .version = HISTORY_VERSION,
+        };
+        is_ok = (fwrite(&header, 1, sizeof(header), p_file) == sizeof(header));
+    }
+    else {
+        is_ok = (fseek(p_file, (long)valid_size, SEEK_SET) == 0);
+    }
+
+    if (is_ok == false || fwrite(frames.data, 1, frames.size, p_file) != frames.size) {
+        result = -2;
+    }
+    if (fclose(p_file) != 0) {
+        result = -2;
+    }
+
+    text_buffer_free(&frames);
+    return result;
+}
+
+
+/**
+ * @brief  打印 object 在最近若干次构建中的大小
+ * @note   还原第一个显示的构建后依次应用其后的 frame
+ * @param  log:       log 输出对象
+ * @param  history:   构建历史
+ * @param  series:    工程及 target 的全部构建
+ * @param  name:      object 名称
+ * @param  build_qty: 最近的构建数量
+ * @retval None
+ */
+void history_object_print(struct log_file *log,
+                          const struct history *history,
+                          const struct history_series *series,
+                          const char *name,
+                          size_t build_qty)
+{
+    size_t start = 0;
+    if (series->qty > build_qty) {
+        start = series->qty - build_qty;
+    }
+
+    log_print(log, "\n[History] %s  %s  (last %zu build(s))\n", series->key, name, series->qty - start);
+    log_print(log, "     BUILD  TIME                       Code    RO Data    RW Data    ZI Data\n");
+
+    uint32_t id = history_name_find(history, name);
+    struct history_snapshot snapshot = {0};
+    bool is_ok = true;
+
+    char time_text[32];
+    for (size_t i = start; i < series->qty; i++)
+    {
+        const struct history_frame *frame = series->frame[i];
+        time_t time = (time_t)frame->time;
+        strftime(time_text, sizeof(time_text), "%Y-%m-%d %H:%M:%S", localtime(&time));
+
+        if (i == start || is_ok == false) {
+            is_ok = history_snapshot_load(history, series, i, &snapshot);
+        } else {
+            is_ok = history_snapshot_apply(history, frame, &snapshot);
+        }
+
+        if ((frame->flags & HISTORY_FLAG_OBJECT) == 0) {
+            log_print(log, "%10zu  %s  (no object info)\n", i + 1, time_text);
+        } else if (is_ok == false) {
+            log_print(log, "%10zu  %s  (invalid)\n", i + 1, time_text);
+        } else if (id == HISTORY_NAME_NONE || snapshot.object[id].name == HISTORY_NAME_NONE) {
+            log_print(log, "%10zu  %s  (not found)\n", i + 1, time_text);
+        } else {
+            const struct record_object *object = &snapshot.object[id];
+            log_print(log, "%10zu  %s %10u %10u %10u %10u\n", 
+                      i + 1, time_text, object->code, object->ro_data, object->rw_data, object->zi_data);
+        }
+    }
+
+    history_snapshot_free(&snapshot);
+}
+
+
+/**
+ * @brief  打印 execution region 的使用率首次达到指定值的构建
+ * @note   
+ * @param  log:     log 输出对象
+ * @param  history: 构建历史
+ * @param  series:  工程及 target 的全部构建
+ * @param  name:    execution region 名称
+ * @param  percent: 使用率，单位 %
+ * @retval None
+ */
+void history_region_print(struct log_file *log,
+                          const struct history *history,
+                          const struct history_series *series,
+                          const char *name,
+                          double percent)
+{
+    uint32_t id = history_name_find(history, name);
+    struct history_snapshot snapshot = {0};
+
+    for (size_t i = 0; i < series->qty && id != HISTORY_NAME_NONE; i++)
+    {
+        const struct history_frame *frame = series->frame[i];
+        if (history_snapshot_apply(history, frame, &snapshot) == false 
+        &&  history_snapshot_load(history, series, i, &snapshot) == false) 
+        {
+            continue;
+        }
+
+        for (size_t j = 0; j < snapshot.region_qty; j++)
+        {
+            const struct record_exec_region *region = &snapshot.region[j];
+            if (region->name != id || region->size == 0) {
+                continue;
+            }
+
+            double usage = (double)region->used_size * 100 / region->size;
+            if (usage >= percent)
+            {
+                char time_text[32];
+                time_t time = (time_t)frame->time;
+                strftime(time_text, sizeof(time_text), "%Y-%m-%d %H:%M:%S", localtime(&time));
+
+                log_print(log, "\n[History] %s  %s >= %.1f%%: build %zu (%s)  %u / %u byte(s)  %.1f%%\n", 
+                          series->key, name, percent, i + 1, time_text, region->used_size, region->size, usage);
+                history_snapshot_free(&snapshot);
+                return;
+            }
+        }
+    }
+
+    history_snapshot_free(&snapshot);
+    log_print(log, "\n[History] %s  %s >= %.1f%%: not reached in %zu build(s)\n", series->key, name, percent, series->qty);
+}
+
+
+/**
+ * @brief  获取影响打印内容的参数
+ * @note   参数不同时不重放分析缓存
+ * @retval 参数的组合
+ */
+uint16_t cache_options(void)
+{
+    return (uint16_t)((_is_display_object ? 0x01 : 0)
+                    | (_is_display_path   ? 0x02 : 0)
+                    | ((_progress_style & 0x03) << 2)
+                    | ((_encoding_type  & 0x03) << 4));
+}
+
+
+/**
+ * @brief  添加分析使用的输入文件
+ * @note   在读取文件之前调用，路径复制到 arena 中。数量超过 CACHE_INPUT_MAX 或出错时，
+ *         qty 置为 CACHE_INPUT_MAX + 1，本次不生成缓存
+ * @param  ctx:       解析上下文
+ * @param  inputs:    [in/out] 输入文件列表
+ * @param  file_path: 文件路径
+ * @param  input:     文件已校验的指纹，为 NULL 时重新获取
+ * @retval None
+ */
+void cache_input_add(struct parse_context *ctx, 
+                     struct cache_input_list *inputs, 
+                     const char *file_path, 
+                     const struct cache_input *input)
+{
+    if (inputs->qty >= CACHE_INPUT_MAX)
+    {
+        inputs->qty = CACHE_INPUT_MAX + 1;
+        return;
+    }
+
+    inputs->path[inputs->qty] = arena_strdup(&ctx->arena, file_path);
+    if (inputs->path[inputs->qty] == NULL)
+    {
+        inputs->qty = CACHE_INPUT_MAX + 1;
+        return;
+    }
+
+    if (input) {
+        inputs->input[inputs->qty] = *input;
+    } 
+    else if (cache_input_get(file_path, &inputs->input[inputs->qty], true) == false) 
+    {
+        inputs->qty = CACHE_INPUT_MAX + 1;
+        return;
+    }
+    inputs->qty++;
+}
+
+
+/**
+ * @brief  获取输入文件的指纹
+ * @note   文件不存在时 size 为 CACHE_INPUT_MISSING，不修改 path 成员
+ * @param  file_path: 文件路径
+ * @param  input:     [out] 文件的指纹
+ * @param  is_hash:   是否计算内容的哈希值
+ * @retval true: 成功 | false: 无法读取文件
+ */
+bool cache_input_get(const char *file_path, 
+                     struct cache_input *input, 
+                     bool is_hash)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data;
+
+    input->size = CACHE_INPUT_MISSING;
+    input->time = 0;
+    input->hash = 0;
+    if (GetFileAttributesEx(file_path, GetFileExInfoStandard, &data) == 0) {
+        return true;
+    }
+
+    input->size = ((uint64_t)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+    input->time = ((uint64_t)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+    if (is_hash == false) {
+        return true;
+    }
+
+    struct file_mapping mapping;
+    if (file_mapping_open(&mapping, file_path) == false) {
+        return false;
+    }
+    input->hash = hash_data(mapping.data, mapping.size);
+    file_mapping_close(&mapping);
+
+    return true;
+}
+
+
+/**
+ * @brief  检查输入文件是否改变
+ * @note   大小及修改时间相同时视为未改变，仅修改时间不同时比较内容的哈希值
+ * @param  file_path: 文件路径
+ * @param  input:     上次的指纹
+ * @param  current:   [out] 未改变时为文件当前的指纹
+ * @retval true: 未改变 | false: 已改变
+ */
+bool cache_input_check(const char *file_path, 
+                       const struct cache_input *input, 
+                       struct cache_input *current)
+{
+    if (cache_input_get(file_path, current, false) == false
+    ||  current->size != input->size) 
+    {
+        return false;
+    }
+
+    current->hash = input->hash;
+    if (current->size == CACHE_INPUT_MISSING || current->time == input->time) {
+        return true;
+    }
+
+    /* 重新生成了相同内容的文件，如没有改动的重新编译 */
+    return cache_input_get(file_path, current, true) 
+        && current->hash == input->hash;
+}
+
+
+/**
+ * @brief  重放上次的分析结果
+ * @note   输入文件、参数及上次的记录均未改变时，打印上次的内容并以当前时间生成本次的构建信息。
+ *         本次的记录与已保存的记录相同，无需重新生成
+ * @param  job: 工程分析任务，cache_key 须已填写
+ * @retval true: 已重放 | false: 需要重新分析
+ */
+bool cache_replay(struct project_job *job)
+{
+#if defined(ENABLE_BENCHMARK) && (ENABLE_BENCHMARK != 0)
+    if (_is_benchmark) {
+        return false;
+    }
+#endif
+
+    size_t size = 0;
+    const char *data = record_store_data(job->cache_store, job->cache_key, &size);
+    if (data == NULL || size < sizeof(struct cache_header)) {
+        return false;
+    }
+
+    struct cache_header header;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != CACHE_MAGIC
+    ||  header.version != CACHE_VERSION
+    ||  header.size != size
+    ||  header.options != cache_options()
+    ||  record_section_check(size, header.input_offset,   header.input_qty,    sizeof(struct cache_input)) == false
+    ||  record_section_check(size, header.print_offset,   header.print_size,   sizeof(char)) == false
+    ||  record_section_check(size, header.history_offset, header.history_size, sizeof(char)) == false
+    ||  record_section_check(size, header.string_offset,  header.string_size,  sizeof(char)) == false
+    ||  (header.history_size != 0 && header.history_size < sizeof(struct history_build_header))
+    ||  header.string_size == 0
+    ||  header.record_key >= header.string_size
+    ||  data[header.string_offset + header.string_size - 1] != '\0')
+    {
+        return false;
+    }
+
+    const char *string     = data + header.string_offset;
+    const char *record_key = string + header.record_key;
+    if (record_store_hash(job->record_store, record_key) != header.record_hash) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.input_qty; i++)
+    {
+        struct cache_input input, current;
+        memcpy(&input, data + header.input_offset + i * sizeof(struct cache_input), sizeof(input));
+
+        if (input.path >= header.string_size
+        ||  cache_input_check(string + input.path, &input, &current) == false)
+        {
+            return false;
+        }
+    }
+
+    job->history_build.size = 0;
+    if (header.history_size)
+    {
+        if (text_buffer_append(&job->history_build, data + header.history_offset, header.history_size) == false) {
+            return false;
+        }
+        ((struct history_build_header *)job->history_build.data)->time = (int64_t)time(NULL);
+    }
+
+    strncpy_s(job->record_key, sizeof(job->record_key), record_key, strnlen_s(record_key, sizeof(job->record_key)));
+    log_append(&job->log, true, data + header.print_offset, header.print_size);
+
+    return true;
+}
+
+
+/**
+ * @brief  生成本次的分析缓存
+ * @note   在分析成功后调用，保存输入文件的指纹、打印的内容及本次的构建信息。
+ *         log 没有缓冲时无法获取打印的内容，输入文件无法全部记录时无法校验，均不生成缓存
+ * @param  job:         工程分析任务
+ * @param  inputs:      分析使用的输入文件
+ * @param  record_hash: 本次分析使用的上次记录的哈希值
+ * @retval true: 成功 | false: 内存不足
+ */
+bool cache_image_build(struct project_job *job, 
+                       const struct cache_input_list *inputs, 
+                       uint64_t record_hash)
+{
+    if (job->log.is_buffered == false || inputs->qty > CACHE_INPUT_MAX) {
+        return true;
+    }
+
+    struct cache_header header = {
+        .magic       = CACHE_MAGIC,
+        .version     = CACHE_VERSION,
+        .options     = cache_options(),
+        .record_hash = record_hash,
+        .input_qty   = (uint32_t)inputs->qty,
+    };
+    struct cache_input input[CACHE_INPUT_MAX];
+    struct text_buffer string = {0};
+    struct text_buffer *image = &job->cache_image;
+
+    bool is_ok = record_string_add(&string, job->record_key, &header.record_key);
+    for (size_t i = 0; i < inputs->qty && is_ok; i++)
+    {
+        input[i] = inputs->input[i];
+        is_ok = record_string_add(&string, inputs->path[i], &input[i].path);
+    }
+
+    /* 布局：缓存头 | 输入文件 | 打印的内容 | 构建信息 | 字符串表，各段 8 字节对齐 */
+    header.print_size     = (uint32_t)job->log.print.size;
+    header.history_size   = (uint32_t)job->history_build.size;
+    header.string_size    = (uint32_t)string.size;
+    header.input_offset   = sizeof(struct cache_header);
+    header.print_offset   = header.input_offset + header.input_qty * sizeof(struct cache_input);
+    header.history_offset = (header.print_offset + header.print_size + 7) & ~7u;
+    header.string_offset  = (header.history_offset + header.history_size + 7) & ~7u;
+    header.size           = header.string_offset + header.string_size;
+
+    static const char padding[8] = {0};
+    image->size = 0;
+    is_ok = is_ok
+         && text_buffer_reserve(image, header.size)
+         && text_buffer_append(image, (const char *)&header, sizeof(header))
+         && text_buffer_append(image, (const char *)input, inputs->qty * sizeof(struct cache_input))
+         && text_buffer_append(image, job->log.print.data, header.print_size)
+         && text_buffer_append(image, padding, header.history_offset - image->size)
+         && text_buffer_append(image, job->history_build.data, header.history_size)
+         && text_buffer_append(image, padding, header.string_offset - image->size)
+         && text_buffer_append(image, string.data, string.size);
+
+    text_buffer_free(&string);
+    return is_ok;
+}
+
+
+/**
+ * @brief  加载缓存的工程模型
+ * @note   uvoptx 及 uvprojx 文件均未改变时，还原解析得到的 target、memory 及文件列表，
+ *         并将这些文件加入本次的输入文件。失败时解析上下文保持为空
+ * @param  job:              工程分析任务，cache_key 须已填写
+ * @param  ctx:              解析上下文
+ * @param  inputs:           [in/out] 本次分析使用的输入文件
+ * @param  target_name:      [out] uvoptx 文件中启用的 target 名
+ * @param  target_name_size: target_name 的大小
+ * @param  is_has_target:    [out] 是否已从 uvoptx 文件获取 target 名
+ * @param  uvprojx_file:     [out] uvprojx 文件的信息
+ * @retval true: 已加载 | false: 需要重新解析
+ */
+bool model_load(struct project_job *job, 
+                struct parse_context *ctx, 
+                struct cache_input_list *inputs, 
+                char *target_name, 
+                size_t target_name_size, 
+                bool *is_has_target, 
+                struct uvprojx_info *uvprojx_file)
+{
+    size_t size = 0;
+    const char *data = record_store_data(job->model_store, job->cache_key, &size);
+    if (data == NULL || size < sizeof(struct model_header)) {
+        return false;
+    }
+
+    const struct model_header *header = (const struct model_header *)data;
+    if (header->magic != MODEL_MAGIC
+    ||  header->version != MODEL_VERSION
+    ||  header->size != size
+    ||  header->input_qty > CACHE_INPUT_MAX
+    ||  record_section_check(size, header->input_offset,  header->input_qty,   sizeof(struct cache_input)) == false
+    ||  record_section_check(size, header->memory_offset, header->memory_qty,  sizeof(struct model_memory)) == false
+    ||  record_section_check(size, header->file_offset,   header->file_qty,    sizeof(struct model_file)) == false
+    ||  record_section_check(size, header->string_offset, header->string_size, sizeof(char)) == false
+    ||  header->string_size == 0
+    ||  data[header->string_offset + header->string_size - 1] != '\0')
+    {
+        return false;
+    }
+
+    const char *string = data + header->string_offset;
+    const struct model_memory *memory = (const struct model_memory *)(data + header->memory_offset);
+    const struct model_file *file     = (const struct model_file *)(data + header->file_offset);
+    uint32_t string_size = header->string_size;
+
+    if (header->target_name    >= string_size
+    ||  header->chip           >= string_size
+    ||  header->uvprojx_target >= string_size
+    ||  header->output_name    >= string_size
+    ||  header->output_path    >= string_size
+    ||  header->listing_path   >= string_size)
+    {
+        return false;
+    }
+
+    struct cache_input current[CACHE_INPUT_MAX];
+    for (uint32_t i = 0; i < header->input_qty; i++)
+    {
+        struct cache_input input;
+        memcpy(&input, data + header->input_offset + i * sizeof(struct cache_input), sizeof(input));
+
+        if (input.path >= string_size
+        ||  cache_input_check(string + input.path, &input, &current[i]) == false)
+        {
+            return false;
+        }
+        current[i].path = input.path;
+    }
+
+    /* 输入文件未改变，还原工程模型 */
+    bool is_ok = true;
+    for (uint32_t i = 0; i < header->memory_qty && is_ok; i++)
+    {
+        is_ok = (memory[i].name < string_size || memory[i].name == MODEL_STRING_NONE)
+             && memory_info_add(&ctx->arena, 
+                                &ctx->memory_list, 
+                                memory[i].name == MODEL_STRING_NONE ? NULL : string + memory[i].name, 
+                                memory[i].id, 
+                                memory[i].base_addr, 
+                                memory[i].size, 
+                                (MEMORY_TYPE)memory[i].type, 
+                                memory[i].is_offchip, 
+                                memory[i].is_from_pack);
+    }
+
+    for (uint32_t i = 0; i < header->file_qty && is_ok; i++)
+    {
+        if (file[i].old_name        >= string_size
+        ||  file[i].object_name     >= string_size
+        ||  file[i].new_object_name >= string_size
+        ||  file[i].path            >= string_size)
+        {
+            is_ok = false;
+            break;
+        }
+
+        struct file_path_list *list = (struct file_path_list *)arena_alloc(&ctx->arena, sizeof(struct file_path_list));
+        if (list == NULL)
+        {
+            is_ok = false;
+            break;
+        }
+
+        list->old_name        = intern_add(&_intern_table, string + file[i].old_name,        strlen(string + file[i].old_name));
+        list->object_name     = intern_add(&_intern_table, string + file[i].object_name,     strlen(string + file[i].object_name));
+        list->new_object_name = intern_add(&_intern_table, string + file[i].new_object_name, strlen(string + file[i].new_object_name));
+        list->path            = intern_add(&_intern_table, string + file[i].path,            strlen(string + file[i].path));
+        list->file_type       = (OBJECT_FILE_TYPE)file[i].file_type;
+        list->is_rename       = file[i].is_rename;
+        list->next            = NULL;
+        is_ok = list->old_name && list->object_name && list->new_object_name && list->path;
+
+        if (ctx->file_list.tail) {
+            ctx->file_list.tail->next = list;
+        } else {
+            ctx->file_list.head = list;
+        }
+        ctx->file_list.tail = list;
+        ctx->file_list.size++;
+    }
+
+    if (is_ok == false)
+    {
+        memset(&ctx->memory_list, 0, sizeof(ctx->memory_list));
+        memset(&ctx->file_list,   0, sizeof(ctx->file_list));
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header->input_qty; i++) {
+        cache_input_add(ctx, inputs, string + current[i].path, &current[i]);
+    }
+
+    strncpy_s(target_name, target_name_size, string + header->target_name, strnlen_s(string + header->target_name, target_name_size));
+    strncpy_s(uvprojx_file->chip,         sizeof(uvprojx_file->chip),         string + header->chip,           strnlen_s(string + header->chip,           sizeof(uvprojx_file->chip)));
+    strncpy_s(uvprojx_file->target_name,  sizeof(uvprojx_file->target_name),  string + header->uvprojx_target, strnlen_s(string + header->uvprojx_target, sizeof(uvprojx_file->target_name)));
+    strncpy_s(uvprojx_file->output_name,  sizeof(uvprojx_file->output_name),  string + header->output_name,    strnlen_s(string + header->output_name,    sizeof(uvprojx_file->output_name)));
+    strncpy_s(uvprojx_file->output_path,  sizeof(uvprojx_file->output_path),  string + header->output_path,    strnlen_s(string + header->output_path,    sizeof(uvprojx_file->output_path)));
+    strncpy_s(uvprojx_file->listing_path, sizeof(uvprojx_file->listing_path), string + header->listing_path,   strnlen_s(string + header->listing_path,   sizeof(uvprojx_file->listing_path)));
+    uvprojx_file->is_has_pack       = (header->flags & MODEL_FLAG_PACK) != 0;
+    uvprojx_file->is_enable_lto     = (header->flags & MODEL_FLAG_LTO) != 0;
+    uvprojx_file->is_has_user_lib   = (header->flags & MODEL_FLAG_USER_LIB) != 0;
+    uvprojx_file->is_custom_scatter = (header->flags & MODEL_FLAG_CUSTOM_SCATTER) != 0;
+    *is_has_target = (header->flags & MODEL_FLAG_TARGET) != 0;
+
+    return true;
+}
+
+
+/**
+ * @brief  生成本次解析的工程模型
+ * @note   在 uvprojx 文件解析完成、处理重命名之前调用，输入文件为 uvoptx 及 uvprojx 文件。
+ *         输入文件无法全部记录时不生成
+ * @param  job:           工程分析任务
+ * @param  ctx:           解析上下文
+ * @param  inputs:        已读取的输入文件
+ * @param  target_name:   uvoptx 文件中启用的 target 名
+ * @param  is_has_target: 是否已从 uvoptx 文件获取 target 名
+ * @param  uvprojx_file:  uvprojx 文件的信息
+ * @retval true: 成功 | false: 内存不足
+ */
+bool model_image_build(struct project_job *job, 
+                       const struct parse_context *ctx, 
+                       const struct cache_input_list *inputs, 
+                       const char *target_name, 
+                       bool is_has_target, 
+                       const struct uvprojx_info *uvprojx_file)
+{
+    if (inputs->qty > CACHE_INPUT_MAX) {
+        return true;
+    }
+
+    struct model_header header = {
+        .magic      = MODEL_MAGIC,
+        .version    = MODEL_VERSION,
+        .input_qty  = (uint32_t)inputs->qty,
+        .memory_qty = (uint32_t)ctx->memory_list.size,
+        .file_qty   = (uint32_t)ctx->file_list.size,
+    };
+    if (is_has_target) {
+        header.flags |= MODEL_FLAG_TARGET;
+    }
+    if (uvprojx_file->is_has_pack) {
+        header.flags |= MODEL_FLAG_PACK;
+    }
+    if (uvprojx_file->is_enable_lto) {
+        header.flags |= MODEL_FLAG_LTO;
+    }
+    if (uvprojx_file->is_has_user_lib) {
+        header.flags |= MODEL_FLAG_USER_LIB;
+    }
+    if (uvprojx_file->is_custom_scatter) {
+        header.flags |= MODEL_FLAG_CUSTOM_SCATTER;
+    }
+
+    /* 布局：模型头 | 输入文件 | memory | 文件列表 | 字符串表 */
+    header.input_offset  = sizeof(struct model_header);
+    header.memory_offset = (header.input_offset + header.input_qty * sizeof(struct cache_input) + 7) & ~7u;
+    header.file_offset   = header.memory_offset + header.memory_qty * sizeof(struct model_memory);
+    header.string_offset = header.file_offset + header.file_qty * sizeof(struct model_file);
+
+    struct text_buffer string = {0};
+    struct text_buffer *image = &job->model_image;
+    struct cache_input input[CACHE_INPUT_MAX];
+
+    bool is_ok = record_string_add(&string, target_name,                 &header.target_name)
+              && record_string_add(&string, uvprojx_file->chip,          &header.chip)
+              && record_string_add(&string, uvprojx_file->target_name,   &header.uvprojx_target)
+              && record_string_add(&string, uvprojx_file->output_name,   &header.output_name)
+              && record_string_add(&string, uvprojx_file->output_path,   &header.output_path)
+              && record_string_add(&string, uvprojx_file->listing_path,  &header.listing_path);
+
+    for (size_t i = 0; i < inputs->qty && is_ok; i++)
+    {
+        input[i] = inputs->input[i];
+        is_ok = record_string_add(&string, inputs->path[i], &input[i].path);
+    }
+
+    image->size = 0;
+    is_ok = is_ok
+         && text_buffer_reserve(image, header.string_offset)
+         && text_buffer_append(image, (const char *)&header, sizeof(header))
+         && text_buffer_append(image, (const char *)input, inputs->qty * sizeof(struct cache_input));
+
+    static const char padding[8] = {0};
+    is_ok = is_ok && text_buffer_append(image, padding, header.memory_offset - image->size);
+
+    for (struct memory_info *memory = ctx->memory_list.head; 
+         memory != NULL && is_ok; 
+         memory = memory->next)
+    {
+        struct model_memory item = {
+            .id           = (uint32_t)memory->id,
+            .base_addr    = memory->base_addr,
+            .size         = memory->size,
+            .type         = (uint8_t)memory->type,
+            .is_from_pack = memory->is_from_pack,
+            .is_offchip   = memory->is_offchip,
+        };
+        if (memory->name) {
+            is_ok = record_string_add(&string, memory->name, &item.name);
+        } else {
+            item.name = MODEL_STRING_NONE;
+        }
+        is_ok = is_ok && text_buffer_append(image, (const char *)&item, sizeof(item));
+    }
+
+    for (struct file_path_list *path = ctx->file_list.head; 
+         path != NULL && is_ok; 
+         path = path->next)
+    {
+        struct model_file item = {
+            .file_type = (uint8_t)path->file_type,
+            .is_rename = path->is_rename,
+        };
+        is_ok = record_string_add(&string, path->path,     &item.path)
+             && record_string_add(&string, path->old_name, &item.old_name);
+
+        /* 名称均为 intern 字符串，相同的名称只保存一次 */
+        item.object_name = item.old_name;
+        if (is_ok && path->object_name != path->old_name) {
+            is_ok = record_string_add(&string, path->object_name, &item.object_name);
+        }
+        item.new_object_name = item.object_name;
+        if (is_ok && path->new_object_name != path->object_name) {
+            is_ok = record_string_add(&string, path->new_object_name, &item.new_object_name);
+        }
+        is_ok = is_ok && text_buffer_append(image, (const char *)&item, sizeof(item));
+    }
+
+    if (is_ok)
+    {
+        header.string_size = (uint32_t)string.size;
+        header.size        = header.string_offset + header.string_size;
+        memcpy(image->data, &header, sizeof(header));
+        is_ok = text_buffer_append(image, string.data, string.size);
+    }
+
+    text_buffer_free(&string);
+    return is_ok;
+}
+
+
+/**
+ * @brief  以 varint 编码写入数值
+ * @note   每字节 7 位，低位在前，最高位表示后面还有字节
+ * @param  buffer: 编码输出
+ * @param  value:  数值
+ * @retval true: 成功 | false: 内存不足
+ */
+bool varint_write(struct text_buffer *buffer, uint32_t value)
+{
+    char bytes[5];
+    size_t len = 0;
+
+    while (value >= 0x80)
+    {
+        bytes[len++] = (char)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[len++] = (char)value;
+
+    return text_buffer_append(buffer, bytes, len);
+}
+
+
+/**
+ * @brief  读取 varint 编码的数值
+ * @note   
+ * @param  data:  [in/out] 读取位置，成功后指向下一个数值
+ * @param  end:   内容的结束位置
+ * @param  value: [out] 数值
+ * @retval true: 成功 | false: 超出内容范围或数值溢出
+ */
+bool varint_read(const uint8_t **data, const uint8_t *end, uint32_t *value)
+{
+    const uint8_t *p = *data;
+    uint32_t result  = 0;
+
+    for (uint32_t shift = 0; p < end && shift < 35; shift += 7)
+    {
+        uint8_t byte = *p++;
+        if (shift == 28 && byte > 0x0F) {
+            return false;
+        }
+
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            *data  = p;
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief  向记录文件的字符串表添加字符串
+ * @note   
+ * @param  string: 字符串表
+ * @param  str:    字符串
+ * @param  offset: [out] 字符串在字符串表中的偏移
+ * @retval true: 成功 | false: 内存不足
+ */
+bool record_string_add(struct text_buffer *string, const char *str, uint32_t *offset)
+{
+    *offset = (uint32_t)string->size;
+    return text_buffer_append(string, str, strlen(str) + 1);
+}
+
+
+/**
+ * @brief  生成记录文件的内容
+ * @note   object_list 为 NULL 时保留上次记录的 object 信息
+ * @param  image:       [out] 记录文件的内容
+ * @param  object_list: 本次的 object 链表
+ * @param  old_record:  上次的记录文件映射
+ * @param  region_list: 本次的 region 链表
+ * @retval true: 成功 | false: 内存不足
+ */
+bool record_image_build(struct text_buffer *image,
+                        const struct object_list *object_list,
+                        const struct record_view *old_record,
+                        const struct region_list *region_list)
+{
+    struct record_header header = {
+        .magic   = RECORD_MAGIC,
+        .version = RECORD_VERSION,
+    };
+    struct text_buffer string = {0};
+    bool is_ok = true;
+
+    bool is_keep_old_object = false;
+    if (object_list)
+    {
+        header.object_qty = object_list->size;
+        header.flags     |= RECORD_FLAG_OBJECT;
+    }
+    else if (old_record->header && (old_record->header->flags & RECORD_FLAG_OBJECT))
+    {
+        header.object_qty  = old_record->header->object_qty;
+        header.flags      |= RECORD_FLAG_OBJECT;
+        is_keep_old_object = true;
+    }
+
+    for (struct load_region *l_region = region_list->head; l_region != NULL; l_region = l_region->next)
+    {
+        header.load_region_qty++;
+        for (struct exec_region *e_region = l_region->exec_region; e_region != NULL; e_region = e_region->next) {
+            header.exec_region_qty++;
+        }
+    }
+
+    header.object_offset      = sizeof(struct record_header);
+    header.load_region_offset = header.object_offset      + header.object_qty      * sizeof(struct record_object);
+    header.exec_region_offset = header.load_region_offset + header.load_region_qty * sizeof(struct record_load_region);
+    header.string_offset      = header.exec_region_offset + header.exec_region_qty * sizeof(struct record_exec_region);
+
+    image->size = 0;
+    is_ok = text_buffer_reserve(image, header.string_offset)
+         && text_buffer_append(image, (const char *)&header, sizeof(header));
+
+    /* object 段 */
+    if (is_keep_old_object)
+    {
+        for (uint32_t i = 0; i < header.object_qty && is_ok; i++)
+        {
+            struct record_object object = old_record->object[i];
+            is_ok = record_string_add(&string, old_record->string + object.name, &object.name)
+                 && text_buffer_append(image, (const char *)&object, sizeof(object));
+        }
+    }
+    else if (object_list)
+    {
+        for (struct object_info *object_temp = object_list->head; 
+             object_temp != NULL && is_ok; 
+             object_temp = object_temp->next)
+        {
+            struct record_object object = {
+                .code    = object_temp->code,
+                .ro_data = object_temp->ro_data,
+                .rw_data = object_temp->rw_data,
+                .zi_data = object_temp->zi_data,
+            };
+            is_ok = record_string_add(&string, object_temp->name, &object.name)
+                 && text_buffer_append(image, (const char *)&object, sizeof(object));
+        }
+    }
+
+    /* load region 段 */
+    uint32_t exec_region_index = 0;
+    for (struct load_region *l_region = region_list->head; 
+         l_region != NULL && is_ok; 
+         l_region = l_region->next)
+    {
+        struct record_load_region load_region = {
+            .exec_region_index = exec_region_index,
+        };
+        for (struct exec_region *e_region = l_region->exec_region; e_region != NULL; e_region = e_region->next) {
+            load_region.exec_region_qty++;
+        }
+        exec_region_index += load_region.exec_region_qty;
+
+        is_ok = record_string_add(&string, l_region->name, &load_region.name)
+             && text_buffer_append(image, (const char *)&load_region, sizeof(load_region));
+    }
+
+    /* execution region 段 */
+    for (struct load_region *l_region = region_list->head; 
+         l_region != NULL && is_ok; 
+         l_region = l_region->next)
+    {
+        for (struct exec_region *e_region = l_region->exec_region; 
+             e_region != NULL && is_ok; 
+             e_region = e_region->next)
+        {
+            struct record_exec_region exec_region = {
+                .base_addr = e_region->base_addr,
+                .size      = e_region->size,
+                .used_size = e_region->used_size,
+            };
+            is_ok = record_string_add(&string, e_region->name, &exec_region.name)
+                 && text_buffer_append(image, (const char *)&exec_region, sizeof(exec_region));
+        }
+    }
+
+    /* 字符串表至少包含一个 '\0' */
+    if (is_ok && string.size == 0) {
+        is_ok = text_buffer_append(&string, "", 1);
+    }
+    if (is_ok)
+    {
+        header.string_size = (uint32_t)string.size;
+        header.file_size   = header.string_offset + header.string_size;
+        memcpy(image->data, &header, sizeof(header));
+        is_ok = text_buffer_append(image, string.data, string.size);
+    }
+
+    text_buffer_free(&string);
+    return is_ok;
+}
+
+
+/**
+ * @brief  写入记录文件
+ * @note   先写入临时文件再替换原文件，写入中断时不会破坏上次的记录。
+ *         原文件被其他程序短暂占用时替换失败，每隔 10 ms 重试，超过 RECORD_FILE_REPLACE_TIMEOUT 时放弃
+ * @param  file_path: 记录文件的绝对路径
+ * @param  image:     记录文件的内容
+ * @retval 0: 正常 | -4: 文件被占用无法替换 | -x: 错误
+ */
+int record_file_write(const char *file_path, const struct text_buffer *image)
+{
+    size_t temp_path_size = strlen(file_path) + sizeof(".tmp");
+    char *temp_path = (char *)malloc(temp_path_size);
+    if (temp_path == NULL) {
+        return -1;
+    }
+    snprintf(temp_path, temp_path_size, "%s.tmp", file_path);
+
+    int result = 0;
+    FILE *p_file = fopen(temp_path, "wb");
+    if (p_file == NULL)
+    {
+        result = -2;
+        goto __exit;
+    }
+
+    size_t len = fwrite(image->data, 1, image->size, p_file);
+    if (fclose(p_file) != 0 || len != image->size)
+    {
+        DeleteFile(temp_path);
+        result = -3;
+        goto __exit;
+    }
+
+    BOOL is_moved = FALSE;
+    for (uint32_t wait = 0; wait <= RECORD_FILE_REPLACE_TIMEOUT; wait += 10)
+    {
+        is_moved = MoveFileEx(temp_path, file_path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+        if (is_moved) {
+            break;
+        }
+        Sleep(10);
+    }
+    if (is_moved == FALSE)
+    {
+        DeleteFile(temp_path);
+        result = -4;
+    }
+
+__exit:
+    free(temp_path);
+    return result;
+}
+
+
+/**
+ * @brief  object 信息打印处理
+ * @note   
+ * @param  log:             log 输出对象
+ * @param  object_head:     object 文件链表头
+ * @param  max_path_len:    最大路径长度
+ * @param  is_has_record:   是否有记录文件
+ * @retval None
+ */
+void object_print_process(struct log_file *log,
+                          struct object_info *object_head,
+                          size_t max_path_len, 
+                          bool is_has_record)
+{
+    char line_text[1024] = {0};
+
+    if ((max_path_len + 2) < strlen(STR_FILE)) {
+        max_path_len = strlen(STR_FILE);
+    }
+
+    size_t len = max_path_len + 2 - strlen(STR_FILE);
+    if (_is_display_path) {
+        len += strlen("():");
+    }
+
+    size_t left_space  = len / 2;
+    size_t right_space = left_space;
+    if (len % 2) {
+        left_space += 1;
+    } 
+
+    snprintf(line_text, sizeof(line_text), 
+             "%*s%s%*s|         RAM (byte)       |       FLASH (byte)       |\n", 
+             left_space, " ", STR_FILE, right_space, " ");
+
+    len = strnlen_s(line_text, sizeof(line_text));
+    char *line = (char *)malloc(len);
+    size_t i = 0;
+    for (; i < len - 1; i++) {
+        line[i] = '-';
+    }
+    line[i] = '\0';
+    log_print(log, "%s\n", line);
+    log_print(log, "%s", line_text);
+    log_print(log, "%s\n", line);
+    
+    for (struct object_info *obj_info = object_head; 
+         obj_info != NULL; 
+         obj_info = obj_info->next)
+    {
+        if (obj_info->path == NULL) {
+            continue;
+        }
+
+        const char *path  = obj_info->path;
+        char ram_text[MAX_PRJ_NAME_SIZE]   = {0};
+        char flash_text[MAX_PRJ_NAME_SIZE] = {0};
+        size_t path_len   = intern_get(obj_info->path)->len;
+        size_t path_space = max_path_len - path_len + 1;
+        uint32_t ram      = obj_info->rw_data + obj_info->zi_data;
+        uint32_t flash    = obj_info->code + obj_info->ro_data + obj_info->rw_data;
+
+//        if (obj_info->path == NULL || _is_display_path == false) 
+        if (_is_display_path == false) 
+        {
+            path = obj_info->name;
+            if (path == NULL) {
+                path = "UNKNOWN";
+            }
+            path_len   = strnlen_s(path, MAX_PATH);
+            path_space = max_path_len - path_len + 1;
+        }
+
+        if (is_has_record)
+        {
+            if (obj_info->old_object == NULL)
+            {
+                strncpy_s(ram_text,   sizeof(ram_text),   "[NEW]     ", 10);
+                strncpy_s(flash_text, sizeof(flash_text), "[NEW]     ", 10);
+            }
+            else
+            {
+                char ram_sign;
+                char flash_sign;
+                uint32_t old_ram      = obj_info->old_object->rw_data + obj_info->old_object->zi_data;
+                uint32_t old_flash    = obj_info->old_object->code + obj_info->old_object->ro_data + obj_info->old_object->rw_data;
+                uint32_t ram_increm   = 0;
+                uint32_t flash_increm = 0;
+
+                if (ram < old_ram)
+                {
+                    ram_increm = old_ram - ram;
                     ram_sign   = '-';
                 }
-                else
+                else
+                {
+                    ram_increm = ram - old_ram;
+                    ram_sign   = '+';
+                }
+
+                if (flash < old_flash) 
+                {
+                    flash_increm = old_flash - flash;
+                    flash_sign   = '-';
+                }
+                else
+                {
+                    flash_increm = flash - old_flash;
+                    flash_sign   = '+';
+                }
+
+                char str[MAX_PRJ_NAME_SIZE] = {0};
+                size_t str_len   = 0;
+                size_t space_len = 0;
+
+                if (ram_increm)
+                {
+                    snprintf(ram_text, sizeof(ram_text), "[%c%d]", ram_sign, ram_increm);
+                    str_len   = strnlen_s(ram_text, sizeof(ram_text));
+                    space_len = 10 - str_len;
+                    if (space_len)
+                    {
+                        for (size_t i = 0; i < space_len; i++) {
+                            str[i] = ' ';
+                        }
+                        strncat_s(ram_text, sizeof(ram_text), str, space_len);
+                    }
+                }
+                else {
+                    strncpy_s(ram_text, sizeof(ram_text), "          ", 10);
+                }
+
+                if (flash_increm)
+                {
+                    snprintf(flash_text, sizeof(flash_text), "[%c%d]", flash_sign, flash_increm);
+                    str_len   = strnlen_s(flash_text, sizeof(flash_text));
+                    space_len = 10 - str_len;
+                    if (space_len)
+                    {
+                        for (size_t i = 0; i < space_len; i++) {
+                            str[i] = ' ';
+                        }
+                        strncat_s(flash_text, sizeof(flash_text), str, space_len);
+                    }
+                }
+                else {
+                    strncpy_s(flash_text, sizeof(flash_text), "          ", 10);
+                }
+            }
+        }
+        else 
+        {
+            strncpy_s(ram_text,   sizeof(ram_text),   "          ", 10);
+            strncpy_s(flash_text, sizeof(flash_text), "          ", 10);
+        }
+
+        if (_is_display_path) 
+        {
+            snprintf(line_text, sizeof(line_text), 
+                     "%s():%*s |  %10d  %s  |  %10d  %s  |", 
+                     path, path_space, " ", ram, ram_text, flash, flash_text);
+        }
+        else 
+        {
+            snprintf(line_text, sizeof(line_text), 
+                     "%s%*s |  %10d  %s  |  %10d  %s  |", 
+                     obj_info->name, path_space, " ", ram, ram_text, flash, flash_text);
+        }
+        log_print(log, "%s\n", line_text);
+    }
+    log_print(log, "%s\n", line);
+    free(line);
+}
+
+
+/**
+ * @brief  模式零打印内存占用情况
+ * @note   
+ * @param  log:             log 输出对象
+ * @param  memory_list:     memory 链表
+ * @param  e_region:        execution region
+ * @param  mem_type:        指定打印的 execution region 内存类型
+ * @param  max_region_name: 最大的 execution region 名称长度
+ * @param  is_has_record:   是否有记录文件
+ * @param  is_print_null:   是否打印未使用的存储器
+ * @retval None
+ */
+void memory_mode0_print(struct log_file *log,
+                        const struct memory_list *memory_list,
+                        struct exec_region *e_region,
+                        MEMORY_TYPE mem_type,
+                        size_t max_region_name, 
+                        bool is_has_record,
+                        bool is_print_null)
+{
+    bool is_print_head = false;
+    char str[MAX_PRJ_NAME_SIZE] = {0};
+
+    if (mem_type == MEMORY_TYPE_UNKNOWN) 
+    {
+        for (struct exec_region *region = e_region;
+             region != NULL;
+             region = region->next)
+        {
+            if (region->memory_type == MEMORY_TYPE_UNKNOWN) 
+            {
+                if (is_print_head == false) 
+                {
+                    log_print(log, "        UNKNOWN\n");
+                    is_print_head = true;
+                }
+                progress_print(log, region, max_region_name, is_has_record);
+            }
+        }
+        if (is_print_head) {
+            log_print(log, " \n");
+        }
+        return;
+    }
+
+    size_t id = 0;
+    bool is_no_region  = true;
+
+    for (struct memory_info *memory = memory_list->head;
+         memory != NULL;
+         memory = memory->next)
+    {
+        if (memory->type != mem_type) {
+            continue;
+        }
+
+        id++;
+        is_no_region  = true;
+        is_print_head = false;
+
+        if (mem_type == MEMORY_TYPE_RAM) {
+            snprintf(str, sizeof(str), "        RAM %d    ", id);
+        }
+        else if (mem_type == MEMORY_TYPE_FLASH) {
+            snprintf(str, sizeof(str), "        FLASH %d  ", id);
+        }
+
+        for (struct exec_region *region = e_region;
+             region != NULL;
+             region = region->next)
+        {
+            if (region->is_printed == false
+            &&  memory->id   == region->memory_id
+            &&  memory->type == region->memory_type)
+            {
+                if (is_print_head == false)
+                {
+                    log_print(log, "%s%*s [0x%.8X | 0x%.8X (%d)]\n",
+                              str, (int)max_region_name, " ", memory->base_addr, memory->size, memory->size);
+                    is_print_head = true;
+                }
+
+                progress_print(log, region, max_region_name, is_has_record);
+                is_no_region = false;
+            }
+        }
+
+        if (is_no_region 
+        &&  is_print_null 
+        &&  memory->is_from_pack) 
+        {
+            log_print(log, "%s%*s [0x%.8X | 0x%.8X (%d)]\n",
+                      str, (int)max_region_name, " ", memory->base_addr, memory->size, memory->size);
+            log_print(log, "                NULL\n \n");
+        }
+        else {
+            log_print(log, " \n");
+        }
+    }
+}
+
+
+/**
+ * @brief  模式一打印内存占用情况
+ * @note   
+ * @param  log:             log 输出对象
+ * @param  e_region:        execution region
+ * @param  mem_type:        指定打印的 execution region 内存类型
+ * @param  is_offchip:      是否为片外 memory
+ * @param  max_region_name: 最大的 execution region 名称长度
+ * @param  is_has_record:   是否有记录文件
+ * @retval None
+ */
+void memory_mode1_print(struct log_file *log,
+                        struct exec_region *e_region,
+                        MEMORY_TYPE mem_type,
+                        bool is_offchip,
+                        size_t max_region_name, 
+                        bool is_has_record)
+{
+    bool is_print_head = false;
+    char str[MAX_PRJ_NAME_SIZE] = {0};
+
+    if (mem_type == MEMORY_TYPE_UNKNOWN) 
+    {
+        for (struct exec_region *region = e_region;
+             region != NULL;
+             region = region->next)
+        {
+            if (region->memory_type == MEMORY_TYPE_UNKNOWN) 
+            {
+                if (is_print_head == false) 
                 {
-                    ram_increm = ram - old_ram;
-                    ram_sign   = '+';
+                    log_print(log, "        UNKNOWN\n");
+                    is_print_head = true;
                 }
+                progress_print(log, region, max_region_name, is_has_record);
+            }
+        }
+        if (is_print_head) {
+            log_print(log, " \n");
+        }
+        return;
+    }
+
+    if (mem_type == MEMORY_TYPE_RAM) {
+        strncpy_s(str, sizeof(str), "        RAM", strlen("        RAM"));
+    }
+    else if (mem_type == MEMORY_TYPE_FLASH) {
+        strncpy_s(str, sizeof(str), "        FLASH", strlen("        FLASH"));
+    }
+
+    if (is_offchip == false) {
+        strncat_s(str, sizeof(str), " (on-chip)\n", strlen(" (on-chip)\n"));
+    } else {
+        strncat_s(str, sizeof(str), " (off-chip)\n", strlen(" (off-chip)\n"));
+    }
+    
+    for (struct exec_region *region = e_region;
+         region != NULL;
+         region = region->next)
+    {
+        if (region->is_printed  == false
+        &&  region->is_offchip  == is_offchip
+        &&  region->memory_type == mem_type)
+        {
+            if (is_print_head == false)
+            {
+                log_print(log, str);
+                is_print_head = true;
+            }
+            progress_print(log, region, max_region_name, is_has_record);
+            region->is_printed = true;
+        }
+    }
+
+    if (is_print_head) {
+        log_print(log, " \n");
+    }
+}
+
+
+/**
+ * @brief  模式二打印内存占用情况
+ * @note   
+ * @param  log:             log 输出对象
+ * @param  e_region:        execution region
+ * @param  max_region_name: 最大的 execution region 名称长度
+ * @param  is_has_record:   是否有记录文件
+ * @retval None
+ */
+void memory_mode2_print(struct log_file *log,
+                        struct exec_region *e_region,
+                        size_t max_region_name, 
+                        bool is_has_record)
+{
+    for (struct exec_region *region_temp = e_region;
+         region_temp != NULL;
+         region_temp = region_temp->next)
+    {
+        if (region_temp->is_printed == false)
+        {
+            progress_print(log, region_temp, max_region_name, is_has_record);
+            region_temp->is_printed = true;
+        }
+    }
+    log_print(log, " \n");
+}
+
+
+/**
+ * @brief  内存占用进度条化打印
+ * @note   
+ * @param  log:             log 输出对象
+ * @param  region:          execution region
+ * @param  max_region_name: 最大的 execution region 名称长度
+ * @param  is_has_record:   是否有记录文件
+ * @retval None
+ */
+void progress_print(struct log_file *log,
+                    struct exec_region *region,
+                    size_t max_region_name, 
+                    bool is_has_record)
+{
+    char line_text[1024] = {0};
+    double size = 0;
+    double used_size = 0;
+    uint32_t interge = 0;
+    char size_str[MAX_PRJ_NAME_SIZE] = {0};
+    char used_size_str[MAX_PRJ_NAME_SIZE] = {0};
+
+    if (region->used_size < 1024)
+    {
+        used_size = region->used_size;
+        snprintf(used_size_str, sizeof(used_size_str), "%8d", (uint32_t)used_size);
+    }
+    else if (region->used_size < (1024 * 1024))
+    {
+        used_size = (double)region->used_size / 1024;
+        used_size = floor(used_size * 10) / 10;     /* 向下取整一位，防止被四舍五入 */
+        snprintf(used_size_str, sizeof(used_size_str), "%5.1f KB", used_size);
+    }
+    else
+    {
+        used_size = (double)region->used_size / (1024 * 1024);
+        used_size = floor(used_size * 10) / 10;
+        snprintf(used_size_str, sizeof(used_size_str), "%5.1f MB", used_size);
+    }
+
+    if (region->size < 1024)
+    {
+        size = region->size;
+        snprintf(size_str, sizeof(size_str), "%8d", (uint32_t)size);
+    }
+    else if (region->size < (1024 * 1024))
+    {
+        size = (double)region->size / 1024;
+        size = floor(size * 10) / 10;
+        snprintf(size_str, sizeof(size_str), "%5.1f KB", size);
+    }
+    else
+    {
+        size = (double)region->size / (1024 * 1024);
+        size = floor(size * 10) / 10;
+        snprintf(size_str, sizeof(size_str), "%5.1f MB", size);
+    }
+
+    double percent = (double)region->used_size * 100 / region->size;
+    if (percent > 100) {
+        percent = 100;
+    }
+
+    size_t used            = 0;
+    char progress[256]     = {0};
+    uint8_t zi_symbol[2]   = {0};
+    uint8_t used_symbol[2] = {0};
+    uint8_t symbol_size    = 0;
+
+    symbol_size    = 1;
+    zi_symbol[0]   = ZI_SYMBOL_0;
+    used_symbol[0] = USED_SYMBOL_0;
+
+    if (_progress_style == PROGRESS_STYLE_0)
+    {
+        if (_encoding_type == ENCODING_TYPE_GBK)
+        {
+            symbol_size    = 2;
+            zi_symbol[0]   = ZI_SYMBOL_GBK_H;
+            zi_symbol[1]   = ZI_SYMBOL_GBK_L;
+            used_symbol[0] = USED_SYMBOL_GBK_H;
+            used_symbol[1] = USED_SYMBOL_GBK_L;
+        }
+        else if (_encoding_type == ENCODING_TYPE_BIG5)
+        {
+            symbol_size    = 2;
+            zi_symbol[0]   = ZI_SYMBOL_BIG5_H;
+            zi_symbol[1]   = ZI_SYMBOL_BIG5_L;
+            used_symbol[0] = USED_SYMBOL_BIG5_H;
+            used_symbol[1] = USED_SYMBOL_BIG5_L;
+        }
+    }
+    else if (_progress_style == PROGRESS_STYLE_2)
+    {
+        symbol_size    = 1;
+        zi_symbol[0]   = ZI_SYMBOL_1;
+        used_symbol[0] = USED_SYMBOL_1;
+    }
+
+    /* 先填充实际占用部分 */
+    for (; used < ((uint32_t)percent / 2); used++)
+    {
+        memcpy(&progress[symbol_size * used], used_symbol, symbol_size);
+    }
+    /* 小于显示比例，避免是空的 */
+    if (used == 0 && region->used_size != 0)
+    {
+        memcpy(&progress[0], used_symbol, symbol_size);
+        used = 1;
+    }
+    /* 将占用部分的 ZI 部分替换 */
+    for (struct region_block *block = region->zi_block;
+         block != NULL;
+         block = block->next)
+    {
+        size_t zi_start = ((double)block->start_addr - region->base_addr) * 100 / region->size / 2;
+        size_t zi_end   = ((double)block->start_addr + block->size - region->base_addr) * 100 / region->size / 2;
+
+        if (zi_start == 0 && block->start_addr > region->base_addr) {
+            zi_start = 1;
+        }
+        log_save(log, "                [zi start] %zu   [zi end] %zu\n", zi_start, zi_end);
+
+        for (; zi_start < zi_end && zi_start < used; zi_start++) {
+            memcpy(&progress[symbol_size * zi_start], zi_symbol, symbol_size);
+        }
+
+        if ((block->start_addr + block->size) >= (region->base_addr + region->size)) {
+            break;
+        }
+    }
+    /* 剩下未使用部分 */
+    for (size_t unused = 0; unused < (50 - used); unused++){
+        strncat_s(progress, sizeof(progress), UNUSE_SYMBOL, strlen(UNUSE_SYMBOL));
+    }
+
+    size_t space_len = max_region_name - strnlen_s(region->name, max_region_name) + 1;
+    snprintf(line_text, sizeof(line_text),
+             "                %s%*s [0x%.8X]|%s| ( %s / %s ) %5.1f%%  ",
+             region->name, space_len, " ", region->base_addr, progress, used_size_str, size_str, percent);
+
+    if (is_has_record)
+    {
+        if (region->old_exec_region == NULL) {
+            strncat_s(line_text, sizeof(line_text), "[NEW]", 5);
+        }
+        else
+        {
+            char sign;
+            uint32_t data_increm = 0;
+            char str_increm[MAX_PRJ_NAME_SIZE] = {0};
+
+            if (region->used_size < region->old_exec_region->used_size)
+            {
+                sign = '-';
+                data_increm = region->old_exec_region->used_size - region->used_size;
+            }
+            else
+            {
+                sign = '+';
+                data_increm = region->used_size - region->old_exec_region->used_size;
+            }
+
+            if (data_increm)
+            {
+                snprintf(str_increm, sizeof(str_increm), "[%c%d]", sign, data_increm);
+                strncat_s(line_text, sizeof(line_text), str_increm, strnlen_s(str_increm, sizeof(str_increm)));
+            }
+        }
+    }
+    log_print(log, "%s\n", line_text);
+}
+
+
+/**
+ * @brief  打印栈使用情况
+ * @note   
+ * @param  ctx:       解析上下文
+ * @param  file_path: htm 文件路径
+ * @retval None
+ */
+void stack_print_process(struct parse_context *ctx, const char *file_path)
+{
+    struct file_mapping mapping;
+    if (file_mapping_open(&mapping, file_path) == false) {
+        return;
+    }
+
+    struct text_range range = {
+        .start = mapping.data,
+        .end   = mapping.data + mapping.size,
+    };
+    struct text_buffer *line = &ctx->line;
+
+    char *str_p1 = NULL;
+    char *str_p2 = NULL;
+    while (text_range_getline(&range, line))
+    {
+        str_p1 = strstr(line->data, STR_MAX_STACK_USAGE);
+        if (str_p1)
+        {
+            str_p2  = strrchr(line->data, ')');
+            str_p2 += 1;
+            *str_p2 = '\0';
+            log_print(ctx->log, "%s\n \n", str_p1);
+            break;
+        }
+    }
+    file_mapping_close(&mapping);
+    return;
+}
+
+
+/**
+ * @brief  按扩展名搜索文件
+ * @note   本函数不会递归搜索
+ * @param  dir:             要搜索的目录
+ * @param  dir_len:         要搜索的目录长度
+ * @param  extension[]:     扩展名，支持多个
+ * @param  extension_qty:   扩展名数量
+ * @param  list:            [out] 保存搜索到的文件路径
+ * @retval None
+ */
+void search_files_by_extension(const char *dir, 
+                               size_t dir_len,
+                               const char *extension[], 
+                               size_t extension_qty, 
+                               struct prj_path_list *list)
+{
+    HANDLE h_find;
+    WIN32_FIND_DATA find_data;
+
+    /* 加上 '*' 以搜索所有文件和文件夹 */
+    char *path = (char *)malloc(dir_len + 3);
+    snprintf(path, dir_len + 3, "%s\\*", dir);
+
+    /* 开始搜索 */
+    h_find = FindFirstFile(path, &find_data);
+    if (h_find == INVALID_HANDLE_VALUE) 
+    {
+        free(path);
+        return;
+    }
+
+    do {
+        /* 如果找到的是文件，判断其后缀是否为 keil 工程 */
+        if ((find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+        {
+            char *str = strrchr(find_data.cFileName, '.');
+            if (str && is_same_string(str, extension, extension_qty))
+            {
+                size_t len = dir_len + strnlen_s(find_data.cFileName, MAX_PATH) + 2;
+                char *file_path = malloc(len);
+                snprintf(file_path, len, "%s\\%s", dir, find_data.cFileName);
+                prj_path_list_add(list, file_path);
+            }
+        }
+    } while (FindNextFile(h_find, &find_data));
+
+    FindClose(h_find);
+    free(path);
+}
+
+
+/**
+ * @brief  log 记录
+ * @note   缓冲模式下写入内存，由 log_file_flush 统一输出，避免多线程输出交错
+ * @param  p_log:    log 输出对象
+ * @param  is_print: 是否打印
+ * @param  fmt:      格式化字符串
+ * @param  ...:      不定长参数 
+ * @retval None
+ */
+void log_write(struct log_file *p_log, 
+               bool is_print, 
+               const char *fmt, 
+               ...)
+{
+    if (p_log == NULL 
+        || (p_log->is_buffered == false && p_log->file == NULL)) 
+    {
+        return;
+    }
+
+    va_list args;
+    size_t len;
+    char buff[1024];
+    
+    va_start(args, fmt);
+
+    memset(buff, 0, sizeof(buff));
+    vsnprintf(buff, sizeof(buff) - 1, fmt, args);
+    len = strnlen(buff, sizeof(buff) - 1);
+    
+    if (p_log->is_buffered)
+    {
+        text_buffer_append(&p_log->log, buff, len);
+        if (is_print) {
+            text_buffer_append(&p_log->print, buff, len);
+        }
+    }
+    else
+    {
+        fputs(buff, p_log->file);
+
+        if (is_print) {
+            printf("%s", buff);
+        }
+    }
+    
+    va_end(args);
+}
+
+
+/**
+ * @brief  追加 log 内容
+ * @note   内容原样写入，不经过格式化，无长度限制
+ * @param  p_log:    log 输出对象
+ * @param  is_print: 是否打印
+ * @param  str:      内容
+ * @param  len:      内容的长度
+ * @retval None
+ */
+void log_append(struct log_file *p_log, 
+                bool is_print, 
+                const char *str, 
+                size_t len)
+{
+    if (p_log == NULL 
+        || (p_log->is_buffered == false && p_log->file == NULL)) 
+    {
+        return;
+    }
+
+    if (p_log->is_buffered)
+    {
+        text_buffer_append(&p_log->log, str, len);
+        if (is_print) {
+            text_buffer_append(&p_log->print, str, len);
+        }
+    }
+    else
+    {
+        fwrite(str, 1, len, p_log->file);
+
+        if (is_print) {
+            fwrite(str, 1, len, stdout);
+        }
+    }
+}
+
+
+/**
+ * @brief  输出缓冲的 log
+ * @note   src 的 log 写入 dst 的文件，打印内容输出到控制台，完成后释放 src 的缓冲
+ * @param  dst: 目标 log 输出对象
+ * @param  src: 缓冲的 log 输出对象
+ * @retval None
+ */
+void log_file_flush(struct log_file *dst, struct log_file *src)
+{
+    if (src->is_buffered == false) {
+        return;
+    }
+
+    if (dst->file && src->log.size) {
+        fwrite(src->log.data, 1, src->log.size, dst->file);
+    }
+    if (src->print.size) {
+        fwrite(src->print.data, 1, src->print.size, stdout);
+    }
+
+    text_buffer_free(&src->log);
+    text_buffer_free(&src->print);
+}
+
+
+/**
+ * @brief  拼接路径
+ * @note   
+ * @param  out_path:        [out] 拼接后输出的路径
+ * @param  out_path_size:   输出的路径的大小
+ * @param  absolute_path:   输入的绝对路径
+ * @param  relative_path:   输入的相对路径
+ * @retval 0: 正常 | -x: 错误
+ */
+int combine_path(char *out_path, 
+                 size_t out_path_size,
+                 const char *absolute_path, 
+                 const char *relative_path)
+{
+    /* 1. 将绝对路径 absolute_path 的文件名和扩展名去除 */
+    strncpy_s(out_path, out_path_size, absolute_path, strnlen_s(absolute_path, MAX_PATH));
+
+    char *last_slash = strrchr(out_path, '\\');
+    if (last_slash == NULL) {
+        last_slash = strrchr(out_path, '/');
+    }
+    if (last_slash != NULL)
+    {
+        /* 说明不是是盘符根目录 */
+        if (*(last_slash - 1) != ':') {
+            *last_slash = '\0';
+        }
+    }
+    else {
+        return -1;
+    }
+
+    /* 2. 读取绝对路径的目录层级 并 记录每一层级的相对偏移值 */
+    size_t hierarchy_count = 0;
+    size_t dir_hierarchy[MAX_DIR_HIERARCHY];
+
+    /* 逐字符遍历路径 */
+    for (size_t i = 0; i < strnlen_s(out_path, out_path_size); i++)
+    {
+        if (out_path[i] == '\\' || out_path[i] == '/')
+        {
+            dir_hierarchy[hierarchy_count++] = i;
+
+            if (hierarchy_count >= MAX_DIR_HIERARCHY) {
+                break;
+            }
+        }
+    }
+
+    /* 3. 读取相对路径 relative_path 的向上层级数 */
+    size_t dir_up_count = 0;
+    size_t valid_path_offset = 0;
+
+    for (size_t i = 0; i < strnlen_s(relative_path, MAX_PATH); )
+    {
+        if (relative_path[i]   == '.' 
+        &&  relative_path[i+1] == '.' 
+        &&  (relative_path[i+2] == '\\' || relative_path[i+2] == '/'))
+        {
+            i += 3;
+            dir_up_count++;
+            valid_path_offset += 3;
+        }
+        else if (relative_path[i]   == '.' 
+        &&       (relative_path[i+1] == '\\' || relative_path[i+1] == '/')) 
+        {
+            valid_path_offset = 2;
+            break;
+        }
+        else {
+            break;
+        }
+    }
+
+    /* 4. 根据 3 获得的级数，缩减绝对路径的目录层级 */
+    if (dir_up_count > 0)
+    {
+        if ((hierarchy_count - dir_up_count) > 0)
+        {
+            hierarchy_count -= (dir_up_count - 1);
+            size_t offset = dir_hierarchy[hierarchy_count - 1];
+            out_path[offset] = '\0';
+        }
+        else {
+            return -2;
+        }
+    }
+
+    /* 5. 根据 2 记录的偏移值和 3 获得的级数，将 absolute_path 和 relative_path 拼接 */
+    strncat_s(out_path, out_path_size, "\\", 1);
+    strncat_s(out_path, out_path_size, &relative_path[valid_path_offset], strnlen_s(&relative_path[valid_path_offset], MAX_PATH));
+
+    for (size_t i = 0; i < strnlen_s(out_path, out_path_size); i++)
+    {
+        if (out_path[i] == '/') {
+            out_path[i] = '\\';
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief  创建新的文件信息并添加进链表
+ * @note   名称及路径均加入 intern 表，长度不受限制。
+ *         未改名时 new_object_name 与 object_name 相同，不是可编译文件及 lib 文件时 object_name 与 old_name 相同
+ * @param  ctx:         解析上下文
+ * @param  name:        文件名
+ * @param  path:        文件所在路径
+ * @param  file_type:   文件类型
+ * @retval true: 成功 | false: 失败
+ */
+bool file_path_add(struct parse_context *ctx,
+                   const struct text_range *name,
+                   const struct text_range *path,
+                   OBJECT_FILE_TYPE file_type)
+{
+    bool is_rename  = false;
+    bool is_object  = (file_type == OBJECT_FILE_TYPE_USER || file_type == OBJECT_FILE_TYPE_LIBRARY);
+    size_t name_len = name->end - name->start;
+    size_t stem_len = name_len;
+
+    struct file_path_list *list = (struct file_path_list *)arena_alloc(&ctx->arena, sizeof(struct file_path_list));
+    if (list == NULL) {
+        return false;
+    }
+
+    list->path        = intern_add(&_intern_table, path->start, path->end - path->start);
+    list->old_name    = intern_add(&_intern_table, name->start, name_len);
+    list->object_name = list->old_name;
+
+    /* 可编译的文件和 lib 文件均会被编译为 .o 文件，此处提前进行文件扩展名的替换，便于后续的字符比对和查找 */
+    if (is_object)
+    {
+        for (size_t i = name_len; i > 0; i--)
+        {
+            if (name->start[i - 1] == '.') 
+            {
+                stem_len = i - 1;
+                break;
+            }
+        }
+
+        struct text_buffer *temp = &ctx->line;
+        temp->size = 0;
+        list->object_name = NULL;
+        if (text_buffer_append(temp, name->start, stem_len)
+        &&  text_buffer_append(temp, ".o", strlen(".o"))) 
+        {
+            list->object_name = intern_add(&_intern_table, temp->data, temp->size);
+        }
+    }
+
+    if (list->path == NULL || list->old_name == NULL || list->object_name == NULL) {
+        return false;
+    }
+
+    if (ctx->object_name_index.buckets == NULL
+    &&  hash_table_init_intern(&ctx->object_name_index, 64, false) == false)
+    {
+        return false;
+    }
+
+    /* 文件名相同的可编译文件会被 keil 改名，此处提前处理，便于后续的字符比对和查找 */
+    /* 索引中只保存每个 object_name 第一次出现的文件 */
+    if (hash_table_find(&ctx->object_name_index, list->object_name)) {
+        is_rename = is_object;
+    }
+    else if (hash_table_add(&ctx->object_name_index, list->object_name, list) == false) {
+        return false;
+    }
+
+    list->new_object_name = list->object_name;
+    list->file_type       = file_type;
+    list->is_rename       = is_rename;
+    list->next            = NULL;
+
+    if (ctx->file_list.tail) {
+        ctx->file_list.tail->next = list;
+    } else {
+        ctx->file_list.head = list;
+    }
+    ctx->file_list.tail = list;
+    ctx->file_list.size++;
+
+    return true;
+}
+
+
+/**
+ * @brief  建立 object 与 keil 工程文件的匹配索引
+ * @note   须在文件改名处理完成后调用。同名时链表中靠后的文件优先匹配
+ * @param  index:       [out] 匹配索引
+ * @param  path_list:   文件路径链表
+ * @retval true: 成功 | false: 失败
+ */
+bool file_path_index_build(struct file_path_index *index, 
+                           const struct file_list *path_list)
+{
+    size_t qty = path_list->size;
+
+    if (hash_table_init_intern(&index->object,         qty,     true) == false
+    ||  hash_table_init_intern(&index->library,        qty / 4, true) == false
+    ||  hash_table_init_intern(&index->library_object, qty / 4, true) == false)
+    {
+        file_path_index_free(index);
+        return false;
+    }
+
+    for (struct file_path_list *path = path_list->head; path != NULL; path = path->next)
+    {
+        bool is_ok = true;
+        if (path->file_type == OBJECT_FILE_TYPE_LIBRARY)
+        {
+            is_ok &= hash_table_add(&index->object,         path->old_name,        path);
+            is_ok &= hash_table_add(&index->library,        path->old_name,        path);
+            is_ok &= hash_table_add(&index->library_object, path->new_object_name, path);
+        }
+        else {
+            is_ok &= hash_table_add(&index->object, path->new_object_name, path);
+        }
+
+        if (is_ok == false) 
+        {
+            file_path_index_free(index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief  释放 object 与 keil 工程文件的匹配索引
+ * @note   
+ * @param  index: 匹配索引
+ * @retval None
+ */
+void file_path_index_free(struct file_path_index *index)
+{
+    hash_table_free(&index->object);
+    hash_table_free(&index->library);
+    hash_table_free(&index->library_object);
+}
+
+
+/**
+ * @brief  创建新的 memory 并添加进链表
+ * @note   
+ * @param  arena:           内存池
+ * @param  memory_list:     memory 链表
+ * @param  name:            memory 名称
+ * @param  id:              memory ID
+ * @param  base_addr:       memory 基地址
+ * @param  size:            memory 大小，单位 byte
+ * @param  mem_type:        memory 类型
+ * @param  is_offchip:      是否为片外 memory
+ * @param  is_from_pack:    信息是否来自 keil 的 pack
+ * @retval true: 成功 | false: 失败
+ */
+bool memory_info_add(struct arena       *arena,
+                     struct memory_list *memory_list,
+                     const char  *name,
+                     size_t      id,
+                     uint32_t    base_addr,
+                     uint32_t    size,
+                     MEMORY_TYPE mem_type,
+                     bool        is_offchip,
+                     bool        is_from_pack)
+{
+    struct memory_info *memory = (struct memory_info *)arena_alloc(arena, sizeof(struct memory_info));
+    if (memory == NULL) {
+        return false;
+    }
+
+    if (name) {
+        memory->name = arena_strdup(arena, name);
+    } else {
+        memory->name = NULL;
+    }
+    memory->id           = id;
+    memory->base_addr    = base_addr;
+    memory->size         = size;
+    memory->type         = mem_type;
+    memory->is_offchip   = is_offchip;
+    memory->is_from_pack = is_from_pack;
+    memory->next         = NULL;
+
+    if (memory_list->tail) {
+        memory_list->tail->next = memory;
+    } else {
+        memory_list->head = memory;
+    }
+    memory_list->tail = memory;
+    memory_list->size++;
+
+    return true;
+}
+
+
+/**
+ * @brief  建立 memory 的地址区间索引
+ * @note   每个 memory 占用 [基地址, 基地址 + 大小)，大小为 0 的 memory 不占用地址。
+ *         以全部边界切分地址后，每一段归属于链表中第一个包含它的 memory，相邻且归属相同的段合并，
+ *         结果按地址排序且互不重叠。memory 数量很少，逐段遍历链表即可
+ * @param  arena:       内存池
+ * @param  index:       [out] 地址区间索引
+ * @param  memory_list: memory 链表
+ * @retval true: 成功 | false: 内存不足
+ */
+bool memory_index_build(struct arena *arena,
+                        struct memory_index *index,
+                        const struct memory_list *memory_list)
+{
+    size_t qty = 0;
+    uint64_t *boundary = (uint64_t *)arena_alloc(arena, (memory_list->size * 2 + 1) * sizeof(uint64_t));
+    index->interval    = (struct memory_interval *)arena_alloc(arena, (memory_list->size * 2 + 1) * sizeof(struct memory_interval));
+    index->qty         = 0;
+    if (boundary == NULL || index->interval == NULL) {
+        return false;
+    }
+
+    for (const struct memory_info *memory = memory_list->head; memory != NULL; memory = memory->next)
+    {
+        if (memory->size)
+        {
+            boundary[qty++] = memory->base_addr;
+            boundary[qty++] = (uint64_t)memory->base_addr + memory->size;
+        }
+    }
+    qsort(boundary, qty, sizeof(uint64_t), memory_boundary_compare);
+
+    for (size_t i = 0; i + 1 < qty; i++)
+    {
+        if (boundary[i] == boundary[i + 1]) {
+            continue;
+        }
+
+        const struct memory_info *owner = NULL;
+        for (const struct memory_info *memory = memory_list->head; memory != NULL; memory = memory->next)
+        {
+            if (boundary[i] >= memory->base_addr
+            &&  boundary[i] <  (uint64_t)memory->base_addr + memory->size)
+            {
+                owner = memory;
+                break;
+            }
+        }
+        if (owner == NULL) {
+            continue;
+        }
+
+        struct memory_interval *last = index->qty ? &index->interval[index->qty - 1] : NULL;
+        if (last && last->memory == owner && last->end == boundary[i]) {
+            last->end = boundary[i + 1];
+        }
+        else 
+        {
+            index->interval[index->qty++] = (struct memory_interval){
+                .start  = boundary[i],
+                .end    = boundary[i + 1],
+                .memory = owner,
+            };
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief  查找地址所属的 memory
+ * @note   二分查找起始地址不大于 addr 的最后一个区间
+ * @param  index: 地址区间索引
+ * @param  addr:  地址
+ * @retval NULL: 不属于任何 memory | 所属的 memory
+ */
+const struct memory_info * memory_index_find(const struct memory_index *index, uint32_t addr)
+{
+    size_t low  = 0;
+    size_t high = index->qty;
+
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (index->interval[mid].start <= addr) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == 0 || addr >= index->interval[low - 1].end) {
+        return NULL;
+    }
+    return index->interval[low - 1].memory;
+}
+
+
+/**
+ * @brief  比较 memory 的地址边界
+ * @note   供 qsort 使用
+ * @param  a: uint64_t * 
+ * @param  b: uint64_t * 
+ * @retval 比较结果
+ */
+int memory_boundary_compare(const void *a, const void *b)
+{
+    uint64_t addr_a = *(const uint64_t *)a;
+    uint64_t addr_b = *(const uint64_t *)b;
+
+    if (addr_a < addr_b) {
+        return -1;
+    }
+    return addr_a > addr_b;
+}
+
+
+/**
+ * @brief  创建新的 load region
+ * @note   
+ * @param  arena:       内存池
+ * @param  region_list: region 链表
+ * @param  name:        region 名称
+ * @retval NULL | struct load_region *
+ */
+struct load_region * load_region_create(struct arena *arena,
+                                        struct region_list *region_list, 
+                                        const struct text_range *name)
+{
+    struct load_region *region = (struct load_region *)arena_alloc(arena, sizeof(struct load_region));
+    if (region == NULL) {
+        return NULL;
+    }
+
+    region->name = arena_strndup(arena, name->start, name->end - name->start);
+    if (region->name == NULL) {
+        return NULL;
+    }
+    region->exec_region      = NULL;
+    region->exec_region_tail = NULL;
+    region->next             = NULL;
+
+    if (region_list->tail) {
+        region_list->tail->next = region;
+    } else {
+        region_list->head = region;
+    }
+    region_list->tail = region;
+    region_list->size++;
+
+    return region;
+}
+
+
+/**
+ * @brief  创建新的 execution region 并添加进 load region 链表
+ * @note   
+ * @param  arena:       内存池
+ * @param  l_region:    所属的 load region
+ * @param  name:        execution region 名
+ * @param  memory_id:   所在的内存 ID
+ * @param  base_addr:   execution region 基地址
+ * @param  size:        execution region 大小，单位 byte
+ * @param  used_size:   execution region 已使用大小，单位 byte
+ * @param  mem_type:    execution region 内存类型
+ * @param  is_offchip:  是否为片外 memory
+ * @retval NULL | struct exec_region *
+ */
+struct exec_region * load_region_add_exec_region(struct arena *arena,
+                                                 struct load_region *l_region, 
+                                                 const struct text_range *name,
+                                                 size_t      memory_id,
+                                                 uint32_t    base_addr,
+                                                 uint32_t    size,
+                                                 uint32_t    used_size,
+                                                 MEMORY_TYPE mem_type,
+                                                 bool        is_offchip)
+{
+    if (l_region == NULL) {
+        return NULL;
+    }
+
+    struct exec_region *e_region = (struct exec_region *)arena_alloc(arena, sizeof(struct exec_region));
+    if (e_region == NULL) {
+        return NULL;
+    }
+
+    e_region->name            = arena_strndup(arena, name->start, name->end - name->start);
+    e_region->memory_id       = memory_id;
+    e_region->base_addr       = base_addr;
+    e_region->size            = size;
+    e_region->used_size       = used_size;
+    e_region->memory_type     = mem_type;
+    e_region->is_offchip      = is_offchip;
+    e_region->is_printed      = false;
+    e_region->zi_block        = NULL;
+    e_region->zi_block_tail   = NULL;
+    e_region->old_exec_region = NULL;
+    e_region->next            = NULL;
+
+    if (l_region->exec_region_tail) {
+        l_region->exec_region_tail->next = e_region;
+    } else {
+        l_region->exec_region = e_region;
+    }
+    l_region->exec_region_tail = e_region;
 
-                if (flash < old_flash) 
-                {
-                    flash_increm = old_flash - flash;
-                    flash_sign   = '-';
-                }
-                else
-                {
-                    flash_increm = flash - old_flash;
-                    flash_sign   = '+';
-                }
+    return e_region;
+}
+
+
+/**
+ * @brief  将旧的 execution region 绑定到同名的新的 execution region 上
+ * @note   名称区分大小写。旧的 execution region 同名时，靠后的优先绑定。
+ *         绑定的是记录文件映射中的内容，记录文件关闭前有效
+ * @param  region_list:     新的 region 链表
+ * @param  old_record:      上次的记录文件映射
+ * @retval true: 成功 | false: 失败
+ */
+bool load_region_bind_old(const struct region_list *region_list, 
+                          const struct record_view *old_record)
+{
+    if (old_record->header == NULL) {
+        return true;
+    }
+
+    size_t qty = old_record->header->exec_region_qty;
+
+    struct hash_table table;
+    if (hash_table_init(&table, qty, false) == false) {
+        return false;
+    }
+
+    for (size_t i = 0; i < qty; i++)
+    {
+        const struct record_exec_region *e_region = &old_record->exec_region[i];
+        if (hash_table_add(&table, old_record->string + e_region->name, (void *)e_region) == false)
+        {
+            hash_table_free(&table);
+            return false;
+        }
+    }
+
+    for (struct load_region *l_region = region_list->head; l_region != NULL; l_region = l_region->next)
+    {
+        for (struct exec_region *e_region = l_region->exec_region; e_region != NULL; e_region = e_region->next) {
+            e_region->old_exec_region = hash_table_find(&table, e_region->name);
+        }
+    }
+
+    hash_table_free(&table);
+    return true;
+}
+
+
+/**
+ * @brief  创建新的 object 文件信息并添加进链表
+ * @note   
+ * @param  arena:       内存池
+ * @param  object_list: object 链表
+ * @param  name:        object 文件名
+ * @param  code:        code 大小，单位 byte
+ * @param  ro_data:     read-only data 大小，单位 byte
+ * @param  rw_data:     read-write data 大小，单位 byte
+ * @param  zi_data:     zero-initialize data 大小，单位 byte
+ * @retval true: 成功 | false: 失败
+ */
+bool object_info_add(struct arena       *arena,
+                     struct object_list *object_list,
+                     const struct text_range *name,
+                     uint32_t   code,
+                     uint32_t   ro_data,
+                     uint32_t   rw_data,
+                     uint32_t   zi_data)
+{
+    struct object_info *object = (struct object_info *)arena_alloc(arena, sizeof(struct object_info));
+    if (object == NULL) {
+        return false;
+    }
+
+    object->name = intern_add(&_intern_table, name->start, name->end - name->start);
+    if (object->name == NULL) {
+        return false;
+    }
+    object->code       = code;
+    object->ro_data    = ro_data;
+    object->rw_data    = rw_data;
+    object->zi_data    = zi_data;
+    object->path       = NULL;
+    object->old_object = NULL;
+    object->next       = NULL;
+
+    if (object_list->tail) {
+        object_list->tail->next = object;
+    } else {
+        object_list->head = object;
+    }
+    object_list->tail = object;
+    object_list->size++;
+
+    return true;
+}
+
+
+/**
+ * @brief  将旧的 object 信息绑定到同名的新的 object 信息上
+ * @note   名称忽略大小写。旧的 object 同名时，靠后的优先绑定。
+ *         绑定的是记录文件映射中的内容，记录文件关闭前有效
+ * @param  object_list:     新的 object 链表
+ * @param  old_record:      上次的记录文件映射
+ * @retval true: 成功 | false: 失败
+ */
+bool object_info_bind_old(const struct object_list *object_list, 
+                          const struct record_view *old_record)
+{
+    if (old_record->header == NULL || (old_record->header->flags & RECORD_FLAG_OBJECT) == 0) {
+        return true;
+    }
+
+    size_t qty = old_record->header->object_qty;
+
+    struct hash_table table;
+    if (hash_table_init(&table, qty, true) == false) {
+        return false;
+    }
+
+    for (size_t i = 0; i < qty; i++)
+    {
+        const struct record_object *object = &old_record->object[i];
+        if (hash_table_add(&table, old_record->string + object->name, (void *)object) == false)
+        {
+            hash_table_free(&table);
+            return false;
+        }
+    }
+
+    for (struct object_info *object = object_list->head; object != NULL; object = object->next) {
+        object->old_object = hash_table_find(&table, object->name);
+    }
+
+    hash_table_free(&table);
+    return true;
+}
+
+
+/**
+ * @brief  初始化动态列表
+ * @note   
+ * @param  capacity: 列表容量
+ * @retval NULL | struct prj_path_list *
+ */
+struct prj_path_list * prj_path_list_init(size_t capacity)
+{
+    struct prj_path_list *list = malloc(sizeof(struct prj_path_list));
+
+    list->items    = malloc(capacity * sizeof(char *));
+    list->capacity = capacity;
+    list->size     = 0;
+
+    return list;
+}
+
+
+/**
+ * @brief  向动态列表添加元素
+ * @note   
+ * @param  list: 列表对象
+ * @param  item: 要新增的项
+ * @retval None
+ */
+void prj_path_list_add(struct prj_path_list *list, char *item)
+{
+    /* 如果数组已满，将其最大容量翻倍 */
+    if (list->size == list->capacity)
+    {
+        list->capacity *= 2;
+        list->items = realloc(list->items, list->capacity * sizeof(char *));
+    }
+    list->items[list->size++] = item;
+}
+
+
+/**
+ * @brief  释放动态列表
+ * @note   
+ * @param  list: 列表对象
+ * @retval None
+ */
+void prj_path_list_free(struct prj_path_list *list)
+{
+    for (size_t i = 0; i < list->size; i++) {
+        free(list->items[i]);
+    }
+    free(list->items);
+    free(list);
+}
+
+
+/**
+ * @brief  某路径是否为 keil 工程
+ * @note   
+ * @param  path: 路径
+ * @retval true: 是 | false: 否
+ */
+bool is_keil_project(const char *path)
+{
+    for (size_t i = 0; i < sizeof(_keil_prj_extension) / sizeof(_keil_prj_extension[0]); i++)
+    {
+        char *dot = strrchr(path, '.');
+        if (dot == NULL) {
+            return false;
+        }
+
+        if (strncmp(dot, _keil_prj_extension[i], strlen(_keil_prj_extension[i])) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief  字符串比对
+ * @note   
+ * @param  str1:     字符串 1
+ * @param  str2[]:   字符串组 2
+ * @param  str2_qty: 字符串组 2 的数量
+ * @retval true: 一致 | false: 不一致
+ */
+bool is_same_string(const char *str1, 
+                    const char *str2[], 
+                    size_t str2_qty)
+{
+    for (size_t i = 0; i < str2_qty; i++)
+    {
+        if (strcmp(str1, str2[i]) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief  计算字符串的哈希值 (FNV-1a)
+ * @note   
+ * @param  str:         字符串
+ * @param  is_nocase:   是否忽略大小写
+ * @retval 哈希值
+ */
+uint32_t hash_string(const char *str, bool is_nocase)
+{
+    uint32_t hash = 2166136261u;
+
+    for (const uint8_t *ch = (const uint8_t *)str; *ch != '\0'; ch++)
+    {
+        uint8_t value = *ch;
+        if (is_nocase && value >= 'A' && value <= 'Z') {
+            value += 'a' - 'A';
+        }
+        hash ^= value;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+/**
+ * @brief  计算文本片段的哈希值 (FNV-1a)
+ * @note   与 hash_string 对相同内容的计算结果相同
+ * @param  str:         文本片段的起始位置
+ * @param  len:         文本片段的长度
+ * @param  is_nocase:   是否忽略大小写
+ * @retval 哈希值
+ */
+uint32_t hash_text(const char *str, size_t len, bool is_nocase)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        uint8_t value = (uint8_t)str[i];
+        if (is_nocase && value >= 'A' && value <= 'Z') {
+            value += 'a' - 'A';
+        }
+        hash ^= value;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+/**
+ * @brief  计算数据的 64 位哈希值 (FNV-1a)
+ * @note   
+ * @param  data: 数据
+ * @param  size: 数据的大小
+ * @retval 哈希值
+ */
+uint64_t hash_data(const char *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= (uint8_t)data[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+
+/**
+ * @brief  初始化哈希表
+ * @note   桶的数量初始为不小于 capacity 的 2 的幂，元素数量超过桶的数量时扩容
+ * @param  table:       哈希表
+ * @param  capacity:    预计的元素数量
+ * @param  is_nocase:   key 是否忽略大小写
+ * @retval true: 成功 | false: 失败
+ */
+bool hash_table_init(struct hash_table *table, 
+                     size_t capacity, 
+                     bool is_nocase)
+{
+    table->bucket_qty = 16;
+    while (table->bucket_qty < capacity) {
+        table->bucket_qty *= 2;
+    }
+
+    table->size      = 0;
+    table->is_nocase = is_nocase;
+    table->is_intern = false;
+    table->buckets   = (struct hash_node **)calloc(table->bucket_qty, sizeof(struct hash_node *));
+
+    return (table->buckets != NULL);
+}
+
+
+/**
+ * @brief  向哈希表添加元素
+ * @note   不复制 key，key 的生命周期须长于哈希表。
+ *         key 重复时不覆盖，后添加的元素优先被查找到
+ * @param  table:   哈希表
+ * @param  key:     key
+ * @param  value:   value
+ * @retval true: 成功 | false: 失败
+ */
+bool hash_table_add(struct hash_table *table, 
+                    const char *key, 
+                    void *value)
+{
+    struct hash_node *node = (struct hash_node *)malloc(sizeof(struct hash_node));
+    if (node == NULL) {
+        return false;
+    }
+
+    node->key   = key;
+    node->value = value;
+    if (table->is_intern) {
+        node->hash = table->is_nocase ? intern_get(key)->nocase_hash : intern_get(key)->hash;
+    } else {
+        node->hash = hash_string(key, table->is_nocase);
+    }
+
+    struct hash_node **bucket = &table->buckets[node->hash & (table->bucket_qty - 1)];
+    node->next = *bucket;
+    *bucket    = node;
+    table->size++;
+
+    /* 扩容失败时沿用原有的桶，仅影响查找速度 */
+    if (table->size > table->bucket_qty) {
+        hash_table_grow(table, table->bucket_qty * 2);
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief  在哈希表中查找 key
+ * @note   
+ * @param  table:   哈希表
+ * @param  key:     key
+ * @retval NULL: 未找到 | 最后添加的同名 key 的 value
+ */
+void * hash_table_find(const struct hash_table *table, const char *key)
+{
+    if (table->buckets == NULL) {
+        return NULL;
+    }
 
-                char str[MAX_PRJ_NAME_SIZE] = {0};
-                size_t str_len   = 0;
-                size_t space_len = 0;
+    if (table->is_intern) 
+    {
+        const struct intern_string *intern = intern_get(key);
+        uint32_t hash = table->is_nocase ? intern->nocase_hash : intern->hash;
 
-                if (ram_increm)
-                {
-                    snprintf(ram_text, sizeof(ram_text), "[%c%d]", ram_sign, ram_increm);
-                    str_len   = strnlen_s(ram_text, sizeof(ram_text));
-                    space_len = 10 - str_len;
-                    if (space_len)
-                    {
-                        for (size_t i = 0; i < space_len; i++) {
-                            str[i] = ' ';
-                        }
-                        strncat_s(ram_text, sizeof(ram_text), str, space_len);
-                    }
-                }
-                else {
-                    strncpy_s(ram_text, sizeof(ram_text), "          ", 10);
-                }
+        for (struct hash_node *node = table->buckets[hash & (table->bucket_qty - 1)];
+             node != NULL;
+             node = node->next)
+        {
+            if (node->key == key 
+            ||  (table->is_nocase && intern_get(node->key)->fold == intern->fold)) 
+            {
+                return node->value;
+            }
+        }
+        return NULL;
+    }
 
-                if (flash_increm)
-                {
-                    snprintf(flash_text, sizeof(flash_text), "[%c%d]", flash_sign, flash_increm);
-                    str_len   = strnlen_s(flash_text, sizeof(flash_text));
-                    space_len = 10 - str_len;
-                    if (space_len)
-                    {
-                        for (size_t i = 0; i < space_len; i++) {
-                            str[i] = ' ';
-                        }
-                        strncat_s(flash_text, sizeof(flash_text), str, space_len);
-                    }
-                }
-                else {
-                    strncpy_s(flash_text, sizeof(flash_text), "          ", 10);
-                }
+    uint32_t hash = hash_string(key, table->is_nocase);
+
+    for (struct hash_node *node = table->buckets[hash & (table->bucket_qty - 1)];
+         node != NULL;
+         node = node->next)
+    {
+        if (node->hash != hash) {
+            continue;
+        }
+        if (table->is_nocase) 
+        {
+            if (strcasecmp(node->key, key) == 0) {
+                return node->value;
             }
         }
-        else 
+        else if (strcmp(node->key, key) == 0) {
+            return node->value;
+        }
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief  释放哈希表
+ * @note   不释放 key 和 value
+ * @param  table: 哈希表
+ * @retval None
+ */
+void hash_table_free(struct hash_table *table)
+{
+    if (table->buckets == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < table->bucket_qty; i++)
+    {
+        struct hash_node *node = table->buckets[i];
+        while (node != NULL)
         {
-            strncpy_s(ram_text,   sizeof(ram_text),   "          ", 10);
-            strncpy_s(flash_text, sizeof(flash_text), "          ", 10);
+            struct hash_node *temp = node;
+            node = node->next;
+            free(temp);
         }
+    }
+    free(table->buckets);
 
-        if (_is_display_path) 
+    table->buckets    = NULL;
+    table->bucket_qty = 0;
+    table->size       = 0;
+}
+
+
+/**
+ * @brief  扩充哈希表的桶
+ * @note   节点保存有哈希值，无需重新计算。同一个旧桶的节点只会分配到同一组新桶，
+ *         将旧桶逆序后再逐个插入新桶的头部，同名 key 的先后顺序保持不变
+ * @param  table:      哈希表
+ * @param  bucket_qty: 新的桶数量，大于当前数量的 2 的幂
+ * @retval true: 成功 | false: 内存不足
+ */
+bool hash_table_grow(struct hash_table *table, size_t bucket_qty)
+{
+    struct hash_node **buckets = (struct hash_node **)calloc(bucket_qty, sizeof(struct hash_node *));
+    if (buckets == NULL) {
+        return false;
+    }
+
+    for (size_t i = 0; i < table->bucket_qty; i++)
+    {
+        struct hash_node *reverse = NULL;
+        for (struct hash_node *node = table->buckets[i], *next; node != NULL; node = next)
         {
-            snprintf(_line_text, sizeof(_line_text), 
-                     "%s():%*s |  %10d  %s  |  %10d  %s  |", 
-                     path, path_space, " ", ram, ram_text, flash, flash_text);
+            next       = node->next;
+            node->next = reverse;
+            reverse    = node;
         }
-        else 
+
+        for (struct hash_node *node = reverse, *next; node != NULL; node = next)
         {
-            snprintf(_line_text, sizeof(_line_text), 
-                     "%s%*s |  %10d  %s  |  %10d  %s  |", 
-                     obj_info->name, path_space, " ", ram, ram_text, flash, flash_text);
+            struct hash_node **bucket = &buckets[node->hash & (bucket_qty - 1)];
+            next       = node->next;
+            node->next = *bucket;
+            *bucket    = node;
         }
-        log_print(_log_file, "%s\n", _line_text);
     }
-    log_print(_log_file, "%s\n", line);
-    free(line);
+
+    free(table->buckets);
+    table->buckets    = buckets;
+    table->bucket_qty = bucket_qty;
+
+    return true;
 }
 
 
 /**
- * @brief  模式零打印内存占用情况
- * @note   
- * @param  e_region:        execution region
- * @param  mem_type:        指定打印的 execution region 内存类型
- * @param  max_region_name: 最大的 execution region 名称长度
- * @param  is_has_record:   是否有记录文件
- * @param  is_print_null:   是否打印未使用的存储器
+ * @brief  初始化 key 均为 intern 字符串的哈希表
+ * @note   添加及查找时不读取字符串的内容，哈希值取自 intern 表
+ * @param  table:       哈希表
+ * @param  capacity:    预计的元素数量
+ * @param  is_nocase:   key 是否忽略大小写
+ * @retval true: 成功 | false: 失败
+ */
+bool hash_table_init_intern(struct hash_table *table, 
+                            size_t capacity, 
+                            bool is_nocase)
+{
+    if (hash_table_init(table, capacity, is_nocase) == false) {
+        return false;
+    }
+
+    table->is_intern = true;
+    return true;
+}
+
+
+/**
+ * @brief  初始化 intern 表
+ * @note   桶在首次添加字符串时分配
+ * @param  table: intern 表
  * @retval None
  */
-void memory_mode0_print(struct exec_region *e_region,
-                        MEMORY_TYPE mem_type,
-                        size_t max_region_name, 
-                        bool is_has_record,
-                        bool is_print_null)
+void intern_table_init(struct intern_table *table)
 {
-    bool is_print_head = false;
-    char str[MAX_PRJ_NAME_SIZE] = {0};
+    memset(table, 0, sizeof(struct intern_table));
+    InitializeSRWLock(&table->lock);
+}
 
-    if (mem_type == MEMORY_TYPE_UNKNOWN) 
+
+/**
+ * @brief  释放 intern 表
+ * @note   全部 intern 字符串失效
+ * @param  table: intern 表
+ * @retval None
+ */
+void intern_table_free(struct intern_table *table)
+{
+    free(table->buckets);
+    free(table->fold_buckets);
+    arena_free(&table->arena);
+
+    table->buckets      = NULL;
+    table->fold_buckets = NULL;
+    table->bucket_qty   = 0;
+    table->size         = 0;
+}
+
+
+/**
+ * @brief  扩充 intern 表的桶
+ * @note   须在持有锁时调用
+ * @param  table:      intern 表
+ * @param  bucket_qty: 新的桶数量，2 的幂
+ * @retval true: 成功 | false: 内存不足
+ */
+bool intern_table_grow(struct intern_table *table, size_t bucket_qty)
+{
+    struct intern_string **buckets      = (struct intern_string **)calloc(bucket_qty, sizeof(struct intern_string *));
+    struct intern_string **fold_buckets = (struct intern_string **)calloc(bucket_qty, sizeof(struct intern_string *));
+    if (buckets == NULL || fold_buckets == NULL)
     {
-        for (struct exec_region *region = e_region;
-             region != NULL;
-             region = region->next)
+        free(buckets);
+        free(fold_buckets);
+        return false;
+    }
+
+    for (size_t i = 0; i < table->bucket_qty; i++)
+    {
+        for (struct intern_string *node = table->buckets[i], *next; node != NULL; node = next)
         {
-            if (region->memory_type == MEMORY_TYPE_UNKNOWN) 
-            {
-                if (is_print_head == false) 
-                {
-                    log_print(_log_file, "        UNKNOWN\n");
-                    is_print_head = true;
-                }
-                progress_print(region, max_region_name, is_has_record);
-            }
+            next = node->next;
+            node->next = buckets[node->hash & (bucket_qty - 1)];
+            buckets[node->hash & (bucket_qty - 1)] = node;
         }
-        if (is_print_head) {
-            log_print(_log_file, " \n");
+        for (struct intern_string *node = table->fold_buckets[i], *next; node != NULL; node = next)
+        {
+            next = node->fold_next;
+            node->fold_next = fold_buckets[node->nocase_hash & (bucket_qty - 1)];
+            fold_buckets[node->nocase_hash & (bucket_qty - 1)] = node;
         }
-        return;
     }
 
-    size_t id = 0;
-    bool is_no_region  = true;
+    free(table->buckets);
+    free(table->fold_buckets);
+    table->buckets      = buckets;
+    table->fold_buckets = fold_buckets;
+    table->bucket_qty   = bucket_qty;
 
-    for (struct memory_info *memory = _memory_info_head;
-         memory != NULL;
-         memory = memory->next)
+    return true;
+}
+
+
+/**
+ * @brief  在 intern 表中查找内容相同的字符串
+ * @note   须在持有锁时调用
+ * @param  table: intern 表
+ * @param  str:   文本片段的起始位置
+ * @param  len:   文本片段的长度
+ * @param  hash:  文本片段的哈希值
+ * @retval NULL: 未找到 | intern 字符串的信息
+ */
+struct intern_string * intern_lookup(const struct intern_table *table, 
+                                     const char *str, 
+                                     size_t len, 
+                                     uint32_t hash)
+{
+    if (table->buckets == NULL) {
+        return NULL;
+    }
+
+    for (struct intern_string *node = table->buckets[hash & (table->bucket_qty - 1)];
+         node != NULL;
+         node = node->next)
     {
-        if (memory->type != mem_type) {
-            continue;
+        if (node->hash == hash && node->len == len && memcmp(node + 1, str, len) == 0) {
+            return node;
         }
+    }
 
-        id++;
-        is_no_region  = true;
-        is_print_head = false;
+    return NULL;
+}
 
-        if (mem_type == MEMORY_TYPE_RAM) {
-            snprintf(str, sizeof(str), "        RAM %d    ", id);
-        }
-        else if (mem_type == MEMORY_TYPE_FLASH) {
-            snprintf(str, sizeof(str), "        FLASH %d  ", id);
-        }
 
-        for (struct exec_region *region = e_region;
-             region != NULL;
-             region = region->next)
-        {
-            if (region->is_printed == false
-            &&  memory->id   == region->memory_id
-            &&  memory->type == region->memory_type)
-            {
-                if (is_print_head == false)
-                {
-                    log_print(_log_file, "%s%*s [0x%.8X | 0x%.8X (%d)]\n",
-                              str, max_region_name, " ", memory->base_addr, memory->size, memory->size);
-                    is_print_head = true;
-                }
+/**
+ * @brief  将文本片段加入 intern 表
+ * @note   内容相同时返回已有的字符串。可在多个线程中同时调用
+ * @param  table: intern 表
+ * @param  str:   文本片段的起始位置，无需以 '\0' 结尾
+ * @param  len:   文本片段的长度
+ * @retval NULL: 内存不足 | intern 字符串，以 '\0' 结尾
+ */
+const char * intern_add(struct intern_table *table, const char *str, size_t len)
+{
+    uint32_t hash = hash_text(str, len, false);
+    struct intern_string *node = NULL;
 
-                progress_print(region, max_region_name, is_has_record);
-                is_no_region = false;
-            }
+    AcquireSRWLockExclusive(&table->lock);
+
+    node = intern_lookup(table, str, len, hash);
+    if (node) {
+        goto __exit;
+    }
+
+    if (table->size >= table->bucket_qty * 2
+    &&  intern_table_grow(table, table->bucket_qty ? table->bucket_qty * 2 : INTERN_BUCKET_QTY) == false) 
+    {
+        goto __exit;
+    }
+
+    node = (struct intern_string *)arena_alloc(&table->arena, sizeof(struct intern_string) + len + 1);
+    if (node == NULL) {
+        goto __exit;
+    }
+
+    node->hash        = hash;
+    node->nocase_hash = hash_text(str, len, true);
+    node->len         = len;
+    node->fold        = NULL;
+    memcpy(node + 1, str, len);
+    ((char *)(node + 1))[len] = '\0';
+
+    /* 忽略大小写后相同的字符串共用第一个加入的字符串作为 fold */
+    for (struct intern_string *fold = table->fold_buckets[node->nocase_hash & (table->bucket_qty - 1)];
+         fold != NULL;
+         fold = fold->fold_next)
+    {
+        if (fold->nocase_hash == node->nocase_hash 
+        &&  fold->len == len 
+        &&  strncasecmp((const char *)(fold + 1), str, len) == 0) 
+        {
+            node->fold = fold;
+            break;
         }
+    }
+    if (node->fold == NULL)
+    {
+        node->fold      = node;
+        node->fold_next = table->fold_buckets[node->nocase_hash & (table->bucket_qty - 1)];
+        table->fold_buckets[node->nocase_hash & (table->bucket_qty - 1)] = node;
+    }
 
-        if (is_no_region 
-        &&  is_print_null 
-        &&  memory->is_from_pack) 
+    node->next = table->buckets[hash & (table->bucket_qty - 1)];
+    table->buckets[hash & (table->bucket_qty - 1)] = node;
+    table->size++;
+
+__exit:
+    ReleaseSRWLockExclusive(&table->lock);
+    return node ? (const char *)(node + 1) : NULL;
+}
+
+
+/**
+ * @brief  在 intern 表中查找文本片段
+ * @note   不加入 intern 表。可在多个线程中同时调用
+ * @param  table: intern 表
+ * @param  str:   文本片段的起始位置，无需以 '\0' 结尾
+ * @param  len:   文本片段的长度
+ * @retval NULL: 不在 intern 表中 | intern 字符串
+ */
+const char * intern_find(struct intern_table *table, const char *str, size_t len)
+{
+    uint32_t hash = hash_text(str, len, false);
+
+    AcquireSRWLockShared(&table->lock);
+    struct intern_string *node = intern_lookup(table, str, len, hash);
+    ReleaseSRWLockShared(&table->lock);
+
+    return node ? (const char *)(node + 1) : NULL;
+}
+
+
+/**
+ * @brief  在 intern 表中忽略大小写查找文本片段
+ * @note   不加入 intern 表。可在多个线程中同时调用。
+ *         返回忽略大小写后相同的字符串中第一个加入的 (fold)，可直接用于忽略大小写的 intern 哈希表
+ * @param  table: intern 表
+ * @param  str:   文本片段的起始位置，无需以 '\0' 结尾
+ * @param  len:   文本片段的长度
+ * @retval NULL: 不在 intern 表中 | fold 字符串
+ */
+const char * intern_find_nocase(struct intern_table *table, const char *str, size_t len)
+{
+    uint32_t nocase_hash = hash_text(str, len, true);
+    const struct intern_string *node = NULL;
+
+    AcquireSRWLockShared(&table->lock);
+    for (node = table->fold_buckets ? table->fold_buckets[nocase_hash & (table->bucket_qty - 1)] : NULL;
+         node != NULL;
+         node = node->fold_next)
+    {
+        if (node->nocase_hash == nocase_hash 
+        &&  node->len == len 
+        &&  strncasecmp((const char *)(node + 1), str, len) == 0) 
         {
-            log_print(_log_file, "%s%*s [0x%.8X | 0x%.8X (%d)]\n",
-                      str, max_region_name, " ", memory->base_addr, memory->size, memory->size);
-            log_print(_log_file, "                NULL\n \n");
+            break;
         }
-        else {
-            log_print(_log_file, " \n");
+    }
+    ReleaseSRWLockShared(&table->lock);
+
+    return node ? (const char *)(node + 1) : NULL;
+}
+
+
+/**
+ * @brief  获取 intern 字符串的信息
+ * @note   str 必须是 intern_add 或 intern_find 返回的字符串。信息加入后不再改变，无需加锁
+ * @param  str: intern 字符串
+ * @retval intern 字符串的信息
+ */
+const struct intern_string * intern_get(const char *str)
+{
+    return (const struct intern_string *)str - 1;
+}
+
+
+/**
+ * @brief  从 arena 中分配内存
+ * @note   按指针大小对齐，不单独释放。当前块不足时申请新块，
+ *         超过 ARENA_BLOCK_SIZE 的请求独占一个块
+ * @param  arena:   内存池
+ * @param  size:    申请的字节数
+ * @retval NULL | 分配的内存
+ */
+void * arena_alloc(struct arena *arena, size_t size)
+{
+    size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+    struct arena_block *block = arena->block;
+    if (block == NULL || block->size - block->used < size)
+    {
+        size_t block_size = ARENA_BLOCK_SIZE;
+        if (size > block_size) {
+            block_size = size;
+        }
+
+        block = (struct arena_block *)malloc(sizeof(struct arena_block) + block_size);
+        if (block == NULL) {
+            return NULL;
         }
+        block->size = block_size;
+        block->used = 0;
+        block->next = arena->block;
+
+        arena->block     = block;
+        arena->reserved += sizeof(struct arena_block) + block_size;
+    }
+
+    void *ptr = (char *)(block + 1) + block->used;
+    block->used += size;
+
+    arena->used += size;
+
+    return ptr;
+}
+
+
+/**
+ * @brief  将字符串复制到 arena 中
+ * @note   
+ * @param  arena:   内存池
+ * @param  str:     字符串
+ * @retval NULL | 复制后的字符串
+ */
+char * arena_strdup(struct arena *arena, const char *str)
+{
+    return arena_strndup(arena, str, strlen(str));
+}
+
+
+/**
+ * @brief  将文本片段复制到 arena 中
+ * @note   片段无需以 '\0' 结尾，复制后的字符串以 '\0' 结尾
+ * @param  arena:   内存池
+ * @param  str:     文本片段的起始位置
+ * @param  len:     文本片段的长度
+ * @retval NULL | 复制后的字符串
+ */
+char * arena_strndup(struct arena *arena, const char *str, size_t len)
+{
+    char *dst = (char *)arena_alloc(arena, len + 1);
+    if (dst) 
+    {
+        memcpy(dst, str, len);
+        dst[len] = '\0';
     }
+
+    return dst;
 }
 
 
 /**
- * @brief  模式一打印内存占用情况
- * @note   
- * @param  e_region:        execution region
- * @param  mem_type:        指定打印的 execution region 内存类型
- * @param  is_offchip:      是否为片外 memory
- * @param  max_region_name: 最大的 execution region 名称长度
- * @param  is_has_record:   是否有记录文件
+ * @brief  释放 arena 的全部内存
+ * @note   分配自 arena 的内存全部失效
+ * @param  arena:   内存池
  * @retval None
  */
-void memory_mode1_print(struct exec_region *e_region,
-                        MEMORY_TYPE mem_type,
-                        bool is_offchip,
-                        size_t max_region_name, 
-                        bool is_has_record)
+void arena_free(struct arena *arena)
 {
-    bool is_print_head = false;
-    char str[MAX_PRJ_NAME_SIZE] = {0};
-
-    if (mem_type == MEMORY_TYPE_UNKNOWN) 
+    struct arena_block *block = arena->block;
+    while (block != NULL)
     {
-        for (struct exec_region *region = e_region;
-             region != NULL;
-             region = region->next)
-        {
-            if (region->memory_type == MEMORY_TYPE_UNKNOWN) 
-            {
-                if (is_print_head == false) 
-                {
-                    log_print(_log_file, "        UNKNOWN\n");
-                    is_print_head = true;
-                }
-                progress_print(region, max_region_name, is_has_record);
-            }
-        }
-        if (is_print_head) {
-            log_print(_log_file, " \n");
-        }
-        return;
+        struct arena_block *temp = block;
+        block = block->next;
+        free(temp);
     }
 
-    if (mem_type == MEMORY_TYPE_RAM) {
-        strncpy_s(str, sizeof(str), "        RAM", strlen("        RAM"));
+    arena->block    = NULL;
+    arena->used     = 0;
+    arena->reserved = 0;
+}
+
+
+/**
+ * @brief  以只读方式将整个文件映射至内存
+ * @note   空文件不创建映射，data 指向空字符串。
+ *         允许其他进程写入、删除及替换文件，映射期间其他实例仍可保存同一记录存储文件
+ * @param  mapping:   [out] 文件映射对象
+ * @param  file_path: 文件路径
+ * @retval true: 成功 | false: 失败
+ */
+bool file_mapping_open(struct file_mapping *mapping, const char *file_path)
+{
+    mapping->mapping = NULL;
+    mapping->data    = NULL;
+    mapping->size    = 0;
+    mapping->file    = CreateFile(file_path, 
+                                  GENERIC_READ, 
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 
+                                  NULL, 
+                                  OPEN_EXISTING, 
+                                  FILE_FLAG_SEQUENTIAL_SCAN, 
+                                  NULL);
+    if (mapping->file == INVALID_HANDLE_VALUE) {
+        return false;
     }
-    else if (mem_type == MEMORY_TYPE_FLASH) {
-        strncpy_s(str, sizeof(str), "        FLASH", strlen("        FLASH"));
+
+    LARGE_INTEGER file_size;
+    if (GetFileSizeEx(mapping->file, &file_size) == 0
+    ||  (ULONGLONG)file_size.QuadPart > SIZE_MAX)
+    {
+        CloseHandle(mapping->file);
+        return false;
     }
 
-    if (is_offchip == false) {
-        strncat_s(str, sizeof(str), " (on-chip)\n", strlen(" (on-chip)\n"));
-    } else {
-        strncat_s(str, sizeof(str), " (off-chip)\n", strlen(" (off-chip)\n"));
+    if (file_size.QuadPart == 0)
+    {
+        mapping->data = "";
+        return true;
     }
-    
-    for (struct exec_region *region = e_region;
-         region != NULL;
-         region = region->next)
+
+    mapping->mapping = CreateFileMapping(mapping->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping->mapping == NULL)
     {
-        if (region->is_printed  == false
-        &&  region->is_offchip  == is_offchip
-        &&  region->memory_type == mem_type)
-        {
-            if (is_print_head == false)
-            {
-                log_print(_log_file, str);
-                is_print_head = true;
-            }
-            progress_print(region, max_region_name, is_has_record);
-            region->is_printed = true;
-        }
+        CloseHandle(mapping->file);
+        return false;
     }
 
-    if (is_print_head) {
-        log_print(_log_file, " \n");
+    mapping->data = (const char *)MapViewOfFile(mapping->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (mapping->data == NULL)
+    {
+        CloseHandle(mapping->mapping);
+        CloseHandle(mapping->file);
+        return false;
     }
+    mapping->size = (size_t)file_size.QuadPart;
+
+    return true;
 }
 
 
 /**
- * @brief  模式二打印内存占用情况
+ * @brief  关闭文件映射
  * @note   
- * @param  e_region:        execution region
- * @param  max_region_name: 最大的 execution region 名称长度
- * @param  is_has_record:   是否有记录文件
+ * @param  mapping: 文件映射对象
  * @retval None
  */
-void memory_mode2_print(struct exec_region *e_region,
-                        size_t max_region_name, 
-                        bool is_has_record)
+void file_mapping_close(struct file_mapping *mapping)
 {
-    for (struct exec_region *region_temp = e_region;
-         region_temp != NULL;
-         region_temp = region_temp->next)
+    if (mapping->mapping)
     {
-        if (region_temp->is_printed == false)
-        {
-            progress_print(region_temp, max_region_name, is_has_record);
-            region_temp->is_printed = true;
-        }
+        UnmapViewOfFile(mapping->data);
+        CloseHandle(mapping->mapping);
     }
-    log_print(_log_file, " \n");
+    CloseHandle(mapping->file);
+
+    mapping->file    = INVALID_HANDLE_VALUE;
+    mapping->mapping = NULL;
+    mapping->data    = NULL;
+    mapping->size    = 0;
 }
 
 
 /**
- * @brief  内存占用进度条化打印
- * @note   
- * @param  region:          execution region
- * @param  max_region_name: 最大的 execution region 名称长度
- * @param  is_has_record:   是否有记录文件
- * @retval None
+ * @brief  从文本区间读取完整的一行
+ * @note   行的长度不受限制，行缓冲按需增长并跨行复用，不会逐行分配内存。
+ *         行尾的 "\r\n" 转换为 "\n"，与以文本模式打开的文件一致
+ * @param  range:   文本区间，读取后起始位置后移
+ * @param  line:    [out] 行缓冲，data 以 '\0' 结尾，size 为不含 '\0' 的长度
+ * @retval true: 成功 | false: 已读取至区间末尾或内存不足
  */
-void progress_print(struct exec_region *region,
-                    size_t max_region_name, 
-                    bool is_has_record)
+bool text_range_getline(struct text_range *range, struct text_buffer *line)
 {
-    double size = 0;
-    double used_size = 0;
-    uint32_t interge = 0;
-    char size_str[MAX_PRJ_NAME_SIZE] = {0};
-    char used_size_str[MAX_PRJ_NAME_SIZE] = {0};
-
-    if (region->used_size < 1024)
-    {
-        used_size = region->used_size;
-        snprintf(used_size_str, sizeof(used_size_str), "%8d", (uint32_t)used_size);
-    }
-    else if (region->used_size < (1024 * 1024))
-    {
-        used_size = (double)region->used_size / 1024;
-        used_size = floor(used_size * 10) / 10;     /* 向下取整一位，防止被四舍五入 */
-        snprintf(used_size_str, sizeof(used_size_str), "%5.1f KB", used_size);
+    if (range->start >= range->end) {
+        return false;
     }
-    else
-    {
-        used_size = (double)region->used_size / (1024 * 1024);
-        used_size = floor(used_size * 10) / 10;
-        snprintf(used_size_str, sizeof(used_size_str), "%5.1f MB", used_size);
+
+    size_t remain = range->end - range->start;
+    size_t len    = remain;
+
+    const char *new_line = _scan.find_byte(range->start, range->end, '\n');
+    if (new_line < range->end) {
+        len = new_line - range->start + 1;
     }
 
-    if (region->size < 1024)
-    {
-        size = region->size;
-        snprintf(size_str, sizeof(size_str), "%8d", (uint32_t)size);
+    if (text_buffer_reserve(line, len + 1) == false) {
+        return false;
     }
-    else if (region->size < (1024 * 1024))
+
+    memcpy(line->data, range->start, len);
+    range->start += len;
+
+    if (len >= 2 && line->data[len - 1] == '\n' && line->data[len - 2] == '\r')
     {
-        size = (double)region->size / 1024;
-        size = floor(size * 10) / 10;
-        snprintf(size_str, sizeof(size_str), "%5.1f KB", size);
+        line->data[len - 2] = '\n';
+        len -= 1;
     }
-    else
+    line->data[len] = '\0';
+    line->size      = len;
+
+    return true;
+}
+
+
+/**
+ * @brief  读取以空格分隔的下一个字段
+ * @note   连续的空格视为一个分隔符，与 strtok_s(str, " ", ...) 的切分相同，但不修改文本
+ * @param  range: 文本区间，读取后起始位置后移至字段之后
+ * @param  field: [out] 字段
+ * @retval true: 成功 | false: 没有更多字段
+ */
+bool text_range_field(struct text_range *range, struct text_range *field)
+{
+    field->start = _scan.skip_byte(range->start, range->end, ' ');
+    if (field->start == range->end)
     {
-        size = (double)region->size / (1024 * 1024);
-        size = floor(size * 10) / 10;
-        snprintf(size_str, sizeof(size_str), "%5.1f MB", size);
+        range->start = range->end;
+        return false;
     }
 
-    double percent = (double)region->used_size * 100 / region->size;
-    if (percent > 100) {
-        percent = 100;
-    }
+    field->end   = _scan.find_byte(field->start, range->end, ' ');
+    range->start = field->end;
+    return true;
+}
 
-    size_t used            = 0;
-    char progress[256]     = {0};
-    uint8_t zi_symbol[2]   = {0};
-    uint8_t used_symbol[2] = {0};
-    uint8_t symbol_size    = 0;
 
-    symbol_size    = 1;
-    zi_symbol[0]   = ZI_SYMBOL_0;
-    used_symbol[0] = USED_SYMBOL_0;
+/**
+ * @brief  解析十进制数
+ * @note   与 strtoul(str, NULL, 10) 相同，只解析开头的数字，没有数字时为 0。
+ *         剩余文本不少于 8 字节时每次转换 8 个数字 (SWAR，按小端序读取)，超出 uint32_t 时为 UINT32_MAX
+ * @param  start: 起始位置
+ * @param  end:   结束位置
+ * @param  value: [out] 数值
+ * @retval 第一个不为数字的位置
+ */
+const char * text_decimal_parse(const char *start, const char *end, uint32_t *value)
+{
+    uint64_t result = 0;
 
-    if (_progress_style == PROGRESS_STYLE_0)
+    while (end - start >= 8)
     {
-        if (_encoding_type == ENCODING_TYPE_GBK)
-        {
-            symbol_size    = 2;
-            zi_symbol[0]   = ZI_SYMBOL_GBK_H;
-            zi_symbol[1]   = ZI_SYMBOL_GBK_L;
-            used_symbol[0] = USED_SYMBOL_GBK_H;
-            used_symbol[1] = USED_SYMBOL_GBK_L;
+        uint64_t chunk;
+        memcpy(&chunk, start, sizeof(chunk));
+
+        /* 每个字节的高 4 位均为 3，加 6 后仍为 3 时是数字。进位只影响非数字之后的字节 */
+        uint64_t digit_flag = ((chunk & 0xF0F0F0F0F0F0F0F0ull) ^ 0x3030303030303030ull)
+                            | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) ^ 0x3030303030303030ull);
+        uint64_t mask = (digit_flag | ((digit_flag & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full)) 
+                      & 0x8080808080808080ull;
+        size_t qty = mask ? (__builtin_ctzll(mask) >> 3) : 8;
+        if (qty == 0) {
+            break;
         }
-        else if (_encoding_type == ENCODING_TYPE_BIG5)
+
+        /* 数字移至高位，低位补 0，再两两合并 */
+        chunk = (chunk - 0x3030303030303030ull) << ((8 - qty) * 8);
+        chunk = ((chunk & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+        chunk = ((chunk & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+        chunk = ((chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+
+        static const uint64_t scale[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+        result = result * scale[qty] + chunk;
+        if (result > UINT32_MAX) {
+            result = (uint64_t)UINT32_MAX + 1;
+        }
+
+        start += qty;
+        if (qty < 8) 
         {
-            symbol_size    = 2;
-            zi_symbol[0]   = ZI_SYMBOL_BIG5_H;
-            zi_symbol[1]   = ZI_SYMBOL_BIG5_L;
-            used_symbol[0] = USED_SYMBOL_BIG5_H;
-            used_symbol[1] = USED_SYMBOL_BIG5_L;
+            *value = (result > UINT32_MAX) ? UINT32_MAX : (uint32_t)result;
+            return start;
         }
     }
-    else if (_progress_style == PROGRESS_STYLE_2)
-    {
-        symbol_size    = 1;
-        zi_symbol[0]   = ZI_SYMBOL_1;
-        used_symbol[0] = USED_SYMBOL_1;
-    }
 
-    /* 先填充实际占用部分 */
-    for (; used < ((uint32_t)percent / 2); used++)
-    {
-        memcpy(&progress[symbol_size * used], used_symbol, symbol_size);
-    }
-    /* 小于显示比例，避免是空的 */
-    if (used == 0 && region->used_size != 0)
+    for (; start < end && (uint8_t)(*start - '0') <= 9; start++)
     {
-        memcpy(&progress[0], used_symbol, symbol_size);
-        used = 1;
+        result = result * 10 + (uint8_t)(*start - '0');
+        if (result > UINT32_MAX) {
+            result = (uint64_t)UINT32_MAX + 1;
+        }
     }
-    /* 将占用部分的 ZI 部分替换 */
-    for (struct region_block *block = region->zi_block;
-         block != NULL;
-         block = block->next)
-    {
-        size_t zi_start = ((double)block->start_addr - region->base_addr) * 100 / region->size / 2;
-        size_t zi_end   = ((double)block->start_addr + block->size - region->base_addr) * 100 / region->size / 2;
 
-        if (zi_start == 0 && block->start_addr > region->base_addr) {
-            zi_start = 1;
-        }
-        log_save(_log_file, "                [zi start] %d   [zi end] %d\n", zi_start, zi_end);
+    *value = (result > UINT32_MAX) ? UINT32_MAX : (uint32_t)result;
+    return start;
+}
 
-        for (; zi_start < zi_end && zi_start < used; zi_start++) {
-            memcpy(&progress[symbol_size * zi_start], zi_symbol, symbol_size);
-        }
 
-        if ((block->start_addr + block->size) >= (region->base_addr + region->size)) {
-            break;
-        }
+/**
+ * @brief  获取 CPU 支持的文本扫描函数
+ * @note   按速度由慢到快排列，最后一个为最快的实现。scalar 实现始终可用
+ * @param  kernels: [out] 扫描函数列表
+ * @param  max_qty: 列表的最大数量，至少为 1
+ * @retval 扫描函数的数量
+ */
+size_t scan_kernel_list(struct scan_kernel *kernels, size_t max_qty)
+{
+    size_t qty = 0;
+    kernels[qty++] = (struct scan_kernel){"scalar", scan_find_byte_scalar, scan_skip_byte_scalar};
+
+#if defined(SCAN_SIMD_X86)
+    __builtin_cpu_init();
+    if (qty < max_qty && __builtin_cpu_supports("sse2")) {
+        kernels[qty++] = (struct scan_kernel){"sse2", scan_find_byte_sse2, scan_skip_byte_sse2};
     }
-    /* 剩下未使用部分 */
-    for (size_t unused = 0; unused < (50 - used); unused++){
-        strncat_s(progress, sizeof(progress), UNUSE_SYMBOL, strlen(UNUSE_SYMBOL));
+    if (qty < max_qty && __builtin_cpu_supports("avx2")) {
+        kernels[qty++] = (struct scan_kernel){"avx2", scan_find_byte_avx2, scan_skip_byte_avx2};
     }
+#endif
 
-    size_t space_len = max_region_name - strnlen_s(region->name, max_region_name) + 1;
-    snprintf(_line_text, sizeof(_line_text),
-             "                %s%*s [0x%.8X]|%s| ( %s / %s ) %5.1f%%  ",
-             region->name, space_len, " ", region->base_addr, progress, used_size_str, size_str, percent);
-
-    if (is_has_record)
-    {
-        if (region->old_exec_region == NULL) {
-            strncat_s(_line_text, sizeof(_line_text), "[NEW]", 5);
-        }
-        else
-        {
-            char sign;
-            uint32_t data_increm = 0;
-            char str_increm[MAX_PRJ_NAME_SIZE] = {0};
+    return qty;
+}
 
-            if (region->used_size < region->old_exec_region->used_size)
-            {
-                sign = '-';
-                data_increm = region->old_exec_region->used_size - region->used_size;
-            }
-            else
-            {
-                sign = '+';
-                data_increm = region->used_size - region->old_exec_region->used_size;
-            }
 
-            if (data_increm)
-            {
-                snprintf(str_increm, sizeof(str_increm), "[%c%d]", sign, data_increm);
-                strncat_s(_line_text, sizeof(_line_text), str_increm, strnlen_s(str_increm, sizeof(str_increm)));
-            }
-        }
-    }
-    log_print(_log_file, "%s\n", _line_text);
+/**
+ * @brief  查找字节
+ * @note   
+ * @param  start: 起始位置
+ * @param  end:   结束位置
+ * @param  c:     查找的字节
+ * @retval 第一个 c 的位置，未找到时为 end
+ */
+const char * scan_find_byte_scalar(const char *start, const char *end, char c)
+{
+    const char *ptr = memchr(start, c, end - start);
+    return ptr ? ptr : end;
 }
 
 
 /**
- * @brief  打印栈使用情况
+ * @brief  跳过连续的字节
  * @note   
- * @param  file_path: htm 文件路径
- * @retval None
+ * @param  start: 起始位置
+ * @param  end:   结束位置
+ * @param  c:     跳过的字节
+ * @retval 第一个不为 c 的位置，未找到时为 end
  */
-void stack_print_process(const char *file_path)
+const char * scan_skip_byte_scalar(const char *start, const char *end, char c)
 {
-    FILE *p_file = fopen(file_path, "r");
-    if (p_file == NULL) {
-        return;
+    while (start < end && *start == c) {
+        start++;
     }
+    return start;
+}
 
-    char *str_p1 = NULL;
-    char *str_p2 = NULL;
-    while (fgets(_line_text, sizeof(_line_text), p_file))
+
+#if defined(SCAN_SIMD_X86)
+/**
+ * @brief  查找字节，每次比较 16 字节
+ * @note   不足 16 字节的尾部使用 scalar 实现
+ * @param  start: 起始位置
+ * @param  end:   结束位置
+ * @param  c:     查找的字节
+ * @retval 第一个 c 的位置，未找到时为 end
+ */
+__attribute__((target("sse2")))
+const char * scan_find_byte_sse2(const char *start, const char *end, char c)
+{
+    const __m128i pattern = _mm_set1_epi8(c);
+
+    for (; end - start >= 16; start += 16)
     {
-        str_p1 = strstr(_line_text, STR_MAX_STACK_USAGE);
-        if (str_p1)
-        {
-            str_p2  = strrchr(_line_text, ')');
-            str_p2 += 1;
-            *str_p2 = '\0';
-            log_print(_log_file, "%s\n \n", str_p1);
-            break;
+        __m128i block = _mm_loadu_si128((const __m128i *)start);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+        if (mask) {
+            return start + __builtin_ctz(mask);
         }
     }
-    fclose(p_file);
-    return;
+    return scan_find_byte_scalar(start, end, c);
 }
 
 
 /**
- * @brief  按扩展名搜索文件
- * @note   本函数不会递归搜索
- * @param  dir:             要搜索的目录
- * @param  dir_len:         要搜索的目录长度
- * @param  extension[]:     扩展名，支持多个
- * @param  extension_qty:   扩展名数量
- * @param  list:            [out] 保存搜索到的文件路径
- * @retval None
+ * @brief  跳过连续的字节，每次比较 16 字节
+ * @note   多数空格只有几个字节，先逐字节检查前 4 个字节
+ * @param  start: 起始位置
+ * @param  end:   结束位置
+ * @param  c:     跳过的字节
+ * @retval 第一个不为 c 的位置，未找到时为 end
  */
-void search_files_by_extension(const char *dir, 
-                               size_t dir_len,
-                               const char *extension[], 
-                               size_t extension_qty, 
-                               struct prj_path_list *list)
+__attribute__((target("sse2")))
+const char * scan_skip_byte_sse2(const char *start, const char *end, char c)
 {
-    HANDLE h_find;
-    WIN32_FIND_DATA find_data;
-
-    /* 加上 '*' 以搜索所有文件和文件夹 */
-    char *path = (char *)malloc(dir_len + 3);
-    snprintf(path, dir_len + 3, "%s\\*", dir);
-
-    /* 开始搜索 */
-    h_find = FindFirstFile(path, &find_data);
-    if (h_find == INVALID_HANDLE_VALUE) 
+    for (size_t i = 0; i < 4; i++, start++)
     {
-        free(path);
-        return;
+        if (start >= end || *start != c) {
+            return start;
+        }
     }
 
-    do {
-        /* 如果找到的是文件，判断其后缀是否为 keil 工程 */
-        if ((find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
-        {
-            char *str = strrchr(find_data.cFileName, '.');
-            if (str && is_same_string(str, extension, extension_qty))
-            {
-                size_t len = dir_len + strnlen_s(find_data.cFileName, MAX_PATH) + 2;
-                char *file_path = malloc(len);
-                snprintf(file_path, len, "%s\\%s", dir, find_data.cFileName);
-                prj_path_list_add(list, file_path);
-            }
+    const __m128i pattern = _mm_set1_epi8(c);
+    for (; end - start >= 16; start += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)start);
+        uint32_t mask = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)) & 0xFFFF;
+        if (mask) {
+            return start + __builtin_ctz(mask);
         }
-    } while (FindNextFile(h_find, &find_data));
-
-    FindClose(h_find);
-    free(path);
+    }
+    return scan_skip_byte_scalar(start, end, c);
 }
 
 
 /**
- * @brief  log 记录
- * @note   
- * @param  p_log:    log 文件
- * @param  is_print: 是否打印
- * @param  fmt:      格式化字符串
- * @param  ...:      不定长参数 
- * @retval None
+ * @brief  查找字节，每次比较 32 字节
+ * @note   不足 32 字节的尾部使用 SSE2 实现
+ * @param  start: 起始位置
+ * @param  end:   结束位置
+ * @param  c:     查找的字节
+ * @retval 第一个 c 的位置，未找到时为 end
  */
-void log_write(FILE *p_log, 
-               bool is_print, 
-               const char *fmt, 
-               ...)
+__attribute__((target("avx2")))
+const char * scan_find_byte_avx2(const char *start, const char *end, char c)
 {
-    if (p_log == NULL) {
-        return;
-    }
-
-    va_list args;
-    uint16_t len;
-    static char buff[1024];
-    
-    va_start(args, fmt);
-
-    memset(buff, 0, sizeof(buff));
-    len = vsnprintf(buff, sizeof(buff) - 1, fmt, args);
-    if (len > sizeof(buff) - 1) {
-        len = sizeof(buff) - 1;
-    }
-    
-    fputs(buff, p_log);
+    const __m256i pattern = _mm256_set1_epi8(c);
 
-    if (is_print) {
-        printf("%s", buff);
+    for (; end - start >= 32; start += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)start);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern));
+        if (mask) {
+            return start + __builtin_ctz(mask);
+        }
     }
-    
-    va_end(args);
+    return scan_find_byte_sse2(start, end, c);
 }
 
 
 /**
- * @brief  拼接路径
- * @note   
- * @param  out_path:        [out] 拼接后输出的路径
- * @param  out_path_size:   输出的路径的大小
- * @param  absolute_path:   输入的绝对路径
- * @param  relative_path:   输入的相对路径
- * @retval 0: 正常 | -x: 错误
+ * @brief  跳过连续的字节，每次比较 32 字节
+ * @note   先使用 SSE2 实现检查前 16 字节，空格较短时无需加载 32 字节
+ * @param  start: 起始位置
+ * @param  end:   结束位置
+ * @param  c:     跳过的字节
+ * @retval 第一个不为 c 的位置，未找到时为 end
  */
-int combine_path(char *out_path, 
-                 size_t out_path_size,
-                 const char *absolute_path, 
-                 const char *relative_path)
+__attribute__((target("avx2")))
+const char * scan_skip_byte_avx2(const char *start, const char *end, char c)
 {
-    /* 1. 将绝对路径 absolute_path 的文件名和扩展名去除 */
-    strncpy_s(out_path, out_path_size, absolute_path, strnlen_s(absolute_path, MAX_PATH));
-
-    char *last_slash = strrchr(out_path, '\\');
-    if (last_slash == NULL) {
-        last_slash = strrchr(out_path, '/');
+    const char *limit = (end - start > 20) ? start + 20 : end;
+    start = scan_skip_byte_sse2(start, limit, c);
+    if (start < limit) {
+        return start;
     }
-    if (last_slash != NULL)
+
+    const __m256i pattern = _mm256_set1_epi8(c);
+    for (; end - start >= 32; start += 32)
     {
-        /* 说明不是是盘符根目录 */
-        if (*(last_slash - 1) != ':') {
-            *last_slash = '\0';
+        __m256i block = _mm256_loadu_si256((const __m256i *)start);
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern));
+        if (mask) {
+            return start + __builtin_ctz(mask);
         }
     }
-    else {
-        return -1;
-    }
+    return scan_skip_byte_sse2(start, end, c);
+}
+#endif
 
-    /* 2. 读取绝对路径的目录层级 并 记录每一层级的相对偏移值 */
-    size_t hierarchy_count = 0;
-    size_t dir_hierarchy[MAX_DIR_HIERARCHY];
 
-    /* 逐字符遍历路径 */
-    for (size_t i = 0; i < strnlen_s(out_path, out_path_size); i++)
+/**
+ * @brief  建立多关键字匹配表
+ * @note   关键字均不短于 2 个字节
+ * @param  matcher: [out] 关键字匹配表
+ * @retval None
+ */
+void keyword_matcher_init(struct keyword_matcher *matcher)
+{
+    static const char *keyword[KEYWORD_QTY] = 
     {
-        if (out_path[i] == '\\' || out_path[i] == '/')
-        {
-            dir_hierarchy[hierarchy_count++] = i;
-
-            if (hierarchy_count >= MAX_DIR_HIERARCHY) {
-                break;
-            }
-        }
+        [KEYWORD_IMAGE_COMPONENT_SIZE] = STR_IMAGE_COMPONENT_SIZE,
+        [KEYWORD_LOAD_REGION]          = STR_LOAD_REGION,
+        [KEYWORD_EXECUTION_REGION]     = STR_EXECUTION_REGION,
+        [KEYWORD_LOAD_BASE]            = STR_LOAD_BASE,
+        [KEYWORD_HEX]                  = "0x",
+        [KEYWORD_ZERO_INIT]            = STR_ZERO_INIT,
+        [KEYWORD_PADDING]              = STR_PADDING,
+        [KEYWORD_OBJECT_FILE]          = ".o",
+        [KEYWORD_LIBRARY_MEMBER_NAME]  = STR_LIBRARY_MEMBER_NAME,
+        [KEYWORD_LIBRARY_NAME]         = STR_LIBRARY_NAME,
+        [KEYWORD_OBJECT_TOTALS]        = STR_OBJECT_TOTALS,
+    };
+
+    memset(matcher, 0, sizeof(struct keyword_matcher));
+
+    for (size_t i = 0; i < KEYWORD_QTY; i++)
+    {
+        matcher->keyword[i] = keyword[i];
+        matcher->length[i]  = strlen(keyword[i]);
+        matcher->first[(uint8_t)keyword[i][0]]  |= KEYWORD_BIT(i);
+        matcher->second[(uint8_t)keyword[i][1]] |= KEYWORD_BIT(i);
     }
+}
 
-    /* 3. 读取相对路径 relative_path 的向上层级数 */
-    size_t dir_up_count = 0;
-    size_t valid_path_offset = 0;
 
-    for (size_t i = 0; i < strnlen_s(relative_path, MAX_PATH); )
-    {
-        if (relative_path[i]   == '.' 
-        &&  relative_path[i+1] == '.' 
-        &&  (relative_path[i+2] == '\\' || relative_path[i+2] == '/'))
-        {
-            i += 3;
-            dir_up_count++;
-            valid_path_offset += 3;
-        }
-        else if (relative_path[i]   == '.' 
-        &&       (relative_path[i+1] == '\\' || relative_path[i+1] == '/')) 
-        {
-            valid_path_offset = 2;
-            break;
-        }
-        else {
-            break;
-        }
-    }
+/**
+ * @brief  查找一行文本中的全部关键字
+ * @note   只扫描一次文本，前两个字节均相符的关键字才逐字比较
+ * @param  matcher: 关键字匹配表
+ * @param  text:    一行文本
+ * @param  len:     文本的长度
+ * @param  match:   [out] 匹配结果
+ * @retval 找到的关键字，第 n 位对应 KEYWORD n
+ */
+uint32_t keyword_match_line(const struct keyword_matcher *matcher, 
+                            const char *text, 
+                            size_t len, 
+                            struct keyword_match *match)
+{
+    uint32_t found = 0;
 
-    /* 4. 根据 3 获得的级数，缩减绝对路径的目录层级 */
-    if (dir_up_count > 0)
+    for (size_t i = 0; i + 1 < len; i++)
     {
-        if ((hierarchy_count - dir_up_count) > 0)
+        uint32_t candidate = matcher->first[(uint8_t)text[i]] 
+                           & matcher->second[(uint8_t)text[i + 1]] 
+                           & ~found;
+
+        for (size_t k = 0; candidate; k++, candidate >>= 1)
         {
-            hierarchy_count -= (dir_up_count - 1);
-            size_t offset = dir_hierarchy[hierarchy_count - 1];
-            out_path[offset] = '\0';
-        }
-        else {
-            return -2;
+            if ((candidate & 1)
+            &&  matcher->length[k] <= len - i
+            &&  memcmp(text + i, matcher->keyword[k], matcher->length[k]) == 0)
+            {
+                found |= KEYWORD_BIT(k);
+                match->pos[k] = text + i;
+            }
         }
     }
 
-    /* 5. 根据 2 记录的偏移值和 3 获得的级数，将 absolute_path 和 relative_path 拼接 */
-    strncat_s(out_path, out_path_size, "\\", 1);
-    strncat_s(out_path, out_path_size, &relative_path[valid_path_offset], strnlen_s(&relative_path[valid_path_offset], MAX_PATH));
+    match->found = found;
+    return found;
+}
 
-    for (size_t i = 0; i < strnlen_s(out_path, out_path_size); i++)
+
+/**
+ * @brief  在文本区间中查找字符串
+ * @note   
+ * @param  range: 文本区间
+ * @param  str:   查找的字符串
+ * @retval 字符串的起始位置，未找到时为 NULL
+ */
+const char * text_range_find(const struct text_range *range, const char *str)
+{
+    size_t len = strlen(str);
+
+    for (const char *ptr = range->start; 
+         (size_t)(range->end - ptr) >= len; 
+         ptr++)
     {
-        if (out_path[i] == '/') {
-            out_path[i] = '\\';
+        ptr = memchr(ptr, str[0], range->end - ptr);
+        if (ptr == NULL || (size_t)(range->end - ptr) < len) {
+            return NULL;
+        }
+        if (memcmp(ptr, str, len) == 0) {
+            return ptr;
         }
     }
-
-    return 0;
+    return NULL;
 }
 
 
 /**
- * @brief  创建新的文件信息并添加进链表
+ * @brief  初始化 XML 解析器
  * @note   
- * @param  path_head:   文件路径链表头
- * @param  name:        文件名
- * @param  path:        文件所在路径
- * @param  file_type:   文件类型
- * @retval true: 成功 | false: 失败
+ * @param  reader: XML 解析器
+ * @param  range:  XML 文件或其中片段的文本区间
+ * @retval None
  */
-bool file_path_add(struct file_path_list **path_head,
-                   const char *name,
-                   const char *path,
-                   OBJECT_FILE_TYPE file_type)
+void xml_reader_init(struct xml_reader *reader, const struct text_range *range)
 {
-    bool is_rename = false;
-    char str[MAX_PRJ_NAME_SIZE] = {0};
-    char old_name[MAX_PRJ_NAME_SIZE] = {0};
-    struct file_path_list **path_list = path_head;
+    reader->range   = *range;
+    reader->content = NULL;
+    reader->empty   = (struct text_range){0};
+}
 
-    memcpy_s(old_name, sizeof(old_name), name, strnlen_s(name, sizeof(old_name)));
 
-    /* 可编译的文件和 lib 文件均会被编译为 .o 文件，此处提前进行文件扩展名的替换，便于后续的字符比对和查找 */
-    if (file_type == OBJECT_FILE_TYPE_USER || file_type == OBJECT_FILE_TYPE_LIBRARY)
+/**
+ * @brief  读取下一个 XML 事件
+ * @note   跳过声明、注释及处理指令，CDATA 作为文本返回。<name/> 依次返回 START 及 END。
+ *         元素名及文本均指向原内容，实体不展开
+ * @param  reader: XML 解析器
+ * @param  event:  [out] 读取到的事件
+ * @retval true: 成功 | false: 已读取至末尾或内容不完整
+ */
+bool xml_reader_next(struct xml_reader *reader, struct xml_event *event)
+{
+    const char *ptr = reader->range.start;
+    const char *end = reader->range.end;
+
+    if (reader->empty.start)
     {
-        char *dot = strrchr(name, '.');
-        if (dot) {
-            *dot = '\0';
-        }
-        strncpy_s(str, sizeof(str), name, strnlen_s(name, sizeof(str)));
-        strncat_s(str, sizeof(str), ".o", strlen(".o"));
-    }
-    else {
-        strncpy_s(str, sizeof(str), name, strnlen_s(name, sizeof(str)));
+        event->type   = XML_EVENT_END;
+        event->start  = reader->empty.start - 1;
+        event->name   = reader->empty;
+        event->text   = (struct text_range){ptr, ptr};
+        reader->empty = (struct text_range){0};
+        return true;
     }
 
-    if (*path_head)
+    while (ptr < end)
     {
-        struct file_path_list *list = *path_head;
-        struct file_path_list *last_list = list;
+        /* 元素之间的文本，忽略缩进等空白 */
+        if (*ptr != '<')
+        {
+            const char *lt = _scan.find_byte(ptr, end, '<');
+
+            const char *text_start = ptr;
+            const char *text_end   = lt;
+            while (text_start < text_end 
+               && (*text_start == ' ' || *text_start == '\t' || *text_start == '\r' || *text_start == '\n')) 
+            {
+                text_start++;
+            }
+            while (text_end > text_start 
+               && (text_end[-1] == ' ' || text_end[-1] == '\t' || text_end[-1] == '\r' || text_end[-1] == '\n')) 
+            {
+                text_end--;
+            }
+
+            reader->range.start = lt;
+            if (text_start < text_end)
+            {
+                event->type  = XML_EVENT_TEXT;
+                event->start = ptr;
+                event->name  = (struct text_range){ptr, ptr};
+                event->text  = (struct text_range){text_start, text_end};
+                return true;
+            }
+            ptr = lt;
+            continue;
+        }
+
+        struct text_range rest = {ptr, end};
+        size_t remain = end - ptr;
+        const char *tail = NULL;
+
+        if (remain >= 4 && memcmp(ptr, "<!--", 4) == 0)
+        {
+            rest.start = ptr + 4;
+            tail = text_range_find(&rest, "-->");
+            if (tail == NULL) {
+                break;
+            }
+            ptr = tail + 3;
+        }
+        else if (remain >= 9 && memcmp(ptr, "<![CDATA[", 9) == 0)
+        {
+            rest.start = ptr + 9;
+            tail = text_range_find(&rest, "]]>");
+            if (tail == NULL) {
+                break;
+            }
+            reader->range.start = tail + 3;
+
+            event->type  = XML_EVENT_TEXT;
+            event->start = ptr;
+            event->name  = (struct text_range){ptr, ptr};
+            event->text  = (struct text_range){ptr + 9, tail};
+            return true;
+        }
+        else if (remain >= 2 && (ptr[1] == '?' || ptr[1] == '!'))
+        {
+            /* <?xml ... ?> 及 <!DOCTYPE ...> */
+            tail = _scan.find_byte(ptr, end, '>');
+            if (tail == end) {
+                break;
+            }
+            ptr = tail + 1;
+        }
+        else
+        {
+            bool is_end = (remain >= 2 && ptr[1] == '/');
+            const char *name = ptr + (is_end ? 2 : 1);
+            const char *name_end = name;
+            while (name_end < end 
+               &&  *name_end != '>' && *name_end != '/' 
+               &&  *name_end != ' ' && *name_end != '\t' && *name_end != '\r' && *name_end != '\n') 
+            {
+                name_end++;
+            }
 
-        /* 文件名相同的可编译文件会被 keil 改名，此处提前处理，便于后续的字符比对和查找 */
-        do {
-            if (is_rename == false
-            &&  (file_type == OBJECT_FILE_TYPE_USER || file_type == OBJECT_FILE_TYPE_LIBRARY)
-            &&  strcmp(str, list->object_name) == 0) 
+            /* 属性值中可能含有 '>' */
+            tail = name_end;
+            while (tail < end && *tail != '>')
             {
-                is_rename = true;
+                if (*tail == '"' || *tail == '\'') 
+                {
+                    tail = memchr(tail + 1, *tail, end - tail - 1);
+                    if (tail == NULL) {
+                        break;
+                    }
+                }
+                tail++;
+            }
+            if (tail == NULL || tail >= end) {
+                break;
             }
-            last_list = list;
-            list = list->next;
-        } while (list);
+            reader->range.start = tail + 1;
 
-        path_list = &last_list->next;
+            event->start = ptr;
+            event->name  = (struct text_range){name, name_end};
+            if (is_end)
+            {
+                event->type = XML_EVENT_END;
+                if (reader->content) {
+                    event->text = (struct text_range){reader->content, ptr};
+                } else {
+                    event->text = (struct text_range){ptr, ptr};
+                }
+                reader->content = NULL;
+            }
+            else 
+            {
+                event->type = XML_EVENT_START;
+                event->text = (struct text_range){tail + 1, tail + 1};
+                if (tail[-1] == '/') 
+                {
+                    reader->empty   = event->name;
+                    reader->content = NULL;
+                } 
+                else {
+                    reader->content = tail + 1;
+                }
+            }
+            return true;
+        }
     }
 
-    *path_list = (struct file_path_list *)malloc(sizeof(struct file_path_list));
-
-    (*path_list)->old_name        = strdup(old_name);
-    (*path_list)->object_name     = strdup(str);
-    (*path_list)->new_object_name = strdup(str);
-    (*path_list)->path            = strdup(path);
-    (*path_list)->file_type       = file_type;
-    (*path_list)->is_rename       = is_rename;
-    (*path_list)->next            = NULL;
-
-    return true;
+    reader->range.start = end;
+    return false;
 }
 
 
 /**
- * @brief  释放文件信息链表占用的内存
+ * @brief  判断事件的元素名
  * @note   
- * @param  path_head: 链表头
- * @retval None
+ * @param  event: XML 事件
+ * @param  name:  元素名
+ * @retval true: 相同 | false: 不同
  */
-void file_path_free(struct file_path_list **path_head)
+bool xml_name_is(const struct xml_event *event, const char *name)
 {
-    struct file_path_list *list = *path_head;
-    while (list != NULL)
-    {
-        struct file_path_list *temp = list;
-        list = list->next;
-        free(temp->old_name);
-        free(temp->object_name);
-        free(temp->new_object_name);
-        free(temp->path);
-        free(temp);
-    }
-    *path_head = NULL;
+    size_t len = strlen(name);
+    return (size_t)(event->name.end - event->name.start) == len 
+        && memcmp(event->name.start, name, len) == 0;
 }
 
 
 /**
- * @brief  创建新的 memory 并添加进链表
- * @note   
- * @param  memory_head:     memory 链表头
- * @param  name:            memory 名称
- * @param  id:              memory ID
- * @param  base_addr:       memory 基地址
- * @param  size:            memory 大小，单位 byte
- * @param  mem_type:        memory 类型
- * @param  is_offchip:      是否为片外 memory
- * @param  is_from_pack:    信息是否来自 keil 的 pack
- * @retval true: 成功 | false: 失败
+ * @brief  复制事件的文本
+ * @note   超出 out_size 的部分被截断，out 始终以 '\0' 结尾
+ * @param  event:    XML 事件
+ * @param  out:      [out] 文本
+ * @param  out_size: out 的大小
+ * @retval true: 完整复制 | false: 已截断
  */
-bool memory_info_add(struct memory_info **memory_head,
-                     const char  *name,
-                     size_t      id,
-                     uint32_t    base_addr,
-                     uint32_t    size,
-                     MEMORY_TYPE mem_type,
-                     bool        is_offchip,
-                     bool        is_from_pack)
+bool xml_text_copy(const struct xml_event *event, char *out, size_t out_size)
 {
-    struct memory_info **memory = memory_head;
-
-    if (*memory_head)
-    {
-        struct memory_info *memory_temp = *memory_head;
-
-        while (memory_temp->next) {
-            memory_temp = memory_temp->next;
-        }
-        memory = &memory_temp->next;
-    }
+    size_t len = event->text.end - event->text.start;
+    bool is_complete = (len < out_size);
 
-    *memory = (struct memory_info *)malloc(sizeof(struct memory_info));
-    if (name) {
-        (*memory)->name = strdup(name);
-    } else {
-        (*memory)->name = NULL;
+    if (is_complete == false) {
+        len = out_size - 1;
     }
-    (*memory)->id           = id;
-    (*memory)->base_addr    = base_addr;
-    (*memory)->size         = size;
-    (*memory)->type         = mem_type;
-    (*memory)->is_offchip   = is_offchip;
-    (*memory)->is_from_pack = is_from_pack;
-    (*memory)->next         = NULL;
+    memcpy(out, event->text.start, len);
+    out[len] = '\0';
 
-    return true;
+    return is_complete;
 }
 
 
 /**
- * @brief  释放 memory 链表占用的内存
- * @note   
- * @param  memory_head: memory 链表头
- * @retval None
+ * @brief  判断事件的文本是否以 '0' 开头
+ * @note   uvprojx 中的选项以 0 表示关闭
+ * @param  event: XML 事件
+ * @retval true: 是 | false: 否或文本为空
  */
-void memory_info_free(struct memory_info **memory_head)
+bool xml_text_is_zero(const struct xml_event *event)
 {
-    struct memory_info *memory = *memory_head;
-    while (memory != NULL)
-    {
-        struct memory_info *temp = memory;
-        memory = memory->next;
-        if (temp->name) {
-            free(temp->name);
-        }
-        free(temp);
-    }
-    *memory_head = NULL;
+    return event->text.start < event->text.end && *event->text.start == '0';
 }
 
 
 /**
- * @brief  创建新的 load region
- * @note   
- * @param  region_head: region 链表头
- * @param  name:        region 名称
- * @retval NULL | struct load_region *
+ * @brief  确保文本缓冲的容量
+ * @note   容量按 2 倍增长
+ * @param  buffer:   文本缓冲
+ * @param  capacity: 需要的最小容量
+ * @retval true: 成功 | false: 内存不足
  */
-struct load_region * load_region_create(struct load_region **region_head, const char *name)
+bool text_buffer_reserve(struct text_buffer *buffer, size_t capacity)
 {
-    struct load_region **region = region_head;
-
-    if (*region_head)
-    {
-        struct load_region *region_temp = *region_head;
-
-        while (region_temp->next) {
-            region_temp = region_temp->next;
-        }
-        region = &region_temp->next;
+    if (capacity <= buffer->capacity) {
+        return true;
     }
 
-    *region = (struct load_region *)malloc(sizeof(struct load_region));
+    size_t new_capacity = buffer->capacity ? buffer->capacity : 256;
+    while (new_capacity < capacity) {
+        new_capacity *= 2;
+    }
 
-    (*region)->name = strdup(name);
-    if ((*region)->name == NULL) {
-        return NULL;
+    char *data = (char *)realloc(buffer->data, new_capacity);
+    if (data == NULL) {
+        return false;
     }
-    (*region)->exec_region = NULL;
-    (*region)->next        = NULL;
+    buffer->data     = data;
+    buffer->capacity = new_capacity;
 
-    return (*region);
+    return true;
 }
 
 
 /**
- * @brief  创建新的 execution region 并添加进 load region 链表
- * @note   
- * @param  l_region:    load region 链表头
- * @param  name:        execution region 名
- * @param  memory_id:   所在的内存 ID
- * @param  base_addr:   execution region 基地址
- * @param  size:        execution region 大小，单位 byte
- * @param  used_size:   execution region 已使用大小，单位 byte
- * @param  mem_type:    execution region 内存类型
- * @param  is_offchip:  是否为片外 memory
- * @retval NULL | struct exec_region *
+ * @brief  追加内容到文本缓冲
+ * @note   data 始终以 '\0' 结尾
+ * @param  buffer: 文本缓冲
+ * @param  str:    追加的内容
+ * @param  len:    追加的长度
+ * @retval true: 成功 | false: 内存不足
  */
-struct exec_region * load_region_add_exec_region(struct load_region **l_region, 
-                                                 const char  *name,
-                                                 size_t      memory_id,
-                                                 uint32_t    base_addr,
-                                                 uint32_t    size,
-                                                 uint32_t    used_size,
-                                                 MEMORY_TYPE mem_type,
-                                                 bool        is_offchip)
+bool text_buffer_append(struct text_buffer *buffer, const char *str, size_t len)
 {
-    if (*l_region == NULL) {
-        return NULL;
+    if (text_buffer_reserve(buffer, buffer->size + len + 1) == false) {
+        return false;
     }
 
-    struct exec_region **e_region = &((*l_region)->exec_region);
-
-    if ((*l_region)->exec_region)
-    {
-        struct exec_region *region_temp = (*l_region)->exec_region;
-
-        while (region_temp->next) {
-            region_temp = region_temp->next;
-        }
-
-        e_region = &region_temp->next;
+    if (len) {
+        memcpy(buffer->data + buffer->size, str, len);
     }
+    buffer->size += len;
+    buffer->data[buffer->size] = '\0';
+
+    return true;
+}
 
-    *e_region = (struct exec_region *)malloc(sizeof(struct exec_region));
 
-    (*e_region)->name            = strdup(name);
-    (*e_region)->memory_id       = memory_id;
-    (*e_region)->base_addr       = base_addr;
-    (*e_region)->size            = size;
-    (*e_region)->used_size       = used_size;
-    (*e_region)->memory_type     = mem_type;
-    (*e_region)->is_offchip      = is_offchip;
-    (*e_region)->is_printed      = false;
-    (*e_region)->zi_block        = NULL;
-    (*e_region)->old_exec_region = NULL;
-    (*e_region)->next            = NULL;
+/**
+ * @brief  释放行缓冲
+ * @note   
+ * @param  line: 行缓冲
+ * @retval None
+ */
+void text_buffer_free(struct text_buffer *line)
+{
+    free(line->data);
 
-    return (*e_region);
+    line->data     = NULL;
+    line->size     = 0;
+    line->capacity = 0;
 }
 
 
 /**
- * @brief  释放 load region 链表占用的内存
+ * @brief  初始化解析上下文
  * @note   
- * @param  region_head: 链表头
+ * @param  ctx: 解析上下文
  * @retval None
  */
-void load_region_free(struct load_region **region_head)
+void parse_context_init(struct parse_context *ctx)
 {
-    struct load_region *l_region = *region_head;
-    while (l_region != NULL)
-    {
-        struct load_region *l_region_temp = l_region;
-
-        struct exec_region *e_region = l_region_temp->exec_region;
-        while (e_region != NULL)
-        {
-            struct exec_region *e_region_temp = e_region;
-            
-            e_region = e_region->next;
-            free(e_region_temp->name);
+    memset(ctx, 0, sizeof(struct parse_context));
 
-            struct region_block *block = e_region_temp->zi_block;
-            while (block != NULL)
-            {
-                struct region_block *block_temp = block;
+    ctx->memory_area.mem_type = MEMORY_TYPE_NONE;
+    ctx->file_path.type       = OBJECT_FILE_TYPE_USER;
+}
 
-                block = block->next;
-                free(block_temp);
-            }
 
-            free(e_region_temp);
-        }
+/**
+ * @brief  释放解析上下文
+ * @note   所有链表节点均分配自 arena，一次释放。释放后上下文可重新初始化并复用
+ * @param  ctx: 解析上下文
+ * @retval None
+ */
+void parse_context_free(struct parse_context *ctx)
+{
+    file_path_index_free(&ctx->file_path_index);
+    hash_table_free(&ctx->object_name_index);
+    text_buffer_free(&ctx->line);
+    arena_free(&ctx->arena);
 
-        l_region = l_region->next;
-        free(l_region_temp->name);
-        free(l_region_temp);
-    }
-    *region_head = NULL;
+    ctx->memory_list = (struct memory_list){0};
+    ctx->file_list   = (struct file_list){0};
 }
 
 
+#if defined(ENABLE_BENCHMARK) && (ENABLE_BENCHMARK != 0)
 /**
- * @brief  创建新的 object 文件信息并添加进链表
- * @note   
- * @param  object_head: 链表头
- * @param  name:        object 文件名
- * @param  code:        code 大小，单位 byte
- * @param  ro_data:     read-only data 大小，单位 byte
- * @param  rw_data:     read-write data 大小，单位 byte
- * @param  zi_data:     zero-initialize data 大小，单位 byte
+ * @brief  生成性能测试用的 map 文件
+ * @note   按 armlink 的格式依次写入 Section Cross References、Image Symbol Table、
+ *         Memory Map of the image 及 Image component sizes，总大小不小于 size
+ * @param  path: 生成的 map 文件路径
+ * @param  size: 生成的 map 文件大小
  * @retval true: 成功 | false: 失败
  */
-bool object_info_add(struct object_info **object_head,
-                     const char *name,
-                     uint32_t   code,
-                     uint32_t   ro_data,
-                     uint32_t   rw_data,
-                     uint32_t   zi_data)
+bool benchmark_map_generate(const char *path, size_t size)
 {
-    struct object_info **object = object_head;
+    const size_t region_row_qty = 16384;
+    const size_t object_qty     = 4096;
+    size_t written = 0;
+    size_t i = 0;
 
-    if (*object_head)
-    {
-        struct object_info *object_temp = *object_head;
+    FILE *p_file = fopen(path, "wb");
+    if (p_file == NULL) {
+        return false;
+    }
 
-        while (object_temp->next) {
-            object_temp = object_temp->next;
-        }
-        object = &object_temp->next;
+    written += fprintf(p_file, "Component: ARM Compiler 6.19 Tool: armlink [5e73cb00]\n\n");
+    written += fprintf(p_file, "==============================================================================\n\n");
+    written += fprintf(p_file, "%s\n\n", STR_SECTION_CROSS_REFERENCES);
+    for (i = 0; written < size / 2 && ferror(p_file) == 0; i++)
+    {
+        written += fprintf(p_file, "    file%zu.o(.text.f%zu) refers to file%zu.o(.text.g%zu) for g%zu\n", 
+                           (i * 7) % object_qty, i, (i * 13) % object_qty, i, i);
     }
 
-    *object = (struct object_info *)malloc(sizeof(struct object_info));
-    (*object)->name = strdup(name);
-    if ((*object)->name == NULL) {
-        return false;
+    written += fprintf(p_file, "\n==============================================================================\n\n");
+    written += fprintf(p_file, "%s\n\n    Global Symbols\n\n", STR_IMAGE_SYMBOL_TABLE);
+    written += fprintf(p_file, "    Symbol Name                              Value     Ov Type        Size  Object(Section)\n\n");
+    for (i = 0; written < size && ferror(p_file) == 0; i++)
+    {
+        written += fprintf(p_file, "    _ZN4ns%zu3fooEv   0x%08x   Thumb Code    %u  file%zu.o(.text.f%zu)\n", 
+                           i, (unsigned int)(0x08000000u + i * 4), (unsigned int)(i * 40503u) % 256, i % object_qty, i);
+    }
+
+    fprintf(p_file, "\n==============================================================================\n\n");
+    fprintf(p_file, "%s\n\n  Image Entry point : 0x08000131\n\n", STR_MEMORY_MAP_OF_THE_IMAGE);
+    fprintf(p_file, "  %s LR_IROM1 (Base: 0x08000000, Size: 0x%08x, Max: 0x00100000, ABSOLUTE)\n\n", 
+            STR_LOAD_REGION, (unsigned int)(region_row_qty * 0x40));
+    fprintf(p_file, "    %s ER_IROM1 (Exec base: 0x08000000, Load base: 0x08000000, Size: 0x%08x, Max: 0x00100000, ABSOLUTE)\n\n", 
+            STR_EXECUTION_REGION, (unsigned int)(region_row_qty * 0x40));
+    fprintf(p_file, "    Exec Addr    Load Addr    Size         Type   Attr      Idx    E Section Name        Object\n\n");
+    for (i = 0; i < region_row_qty; i++)
+    {
+        unsigned int addr = (unsigned int)(0x08000000u + i * 0x40);
+        fprintf(p_file, "    0x%08x   0x%08x   0x00000040   Code   RO        %5zu    .text.f%-13zu file%zu.o\n", 
+                addr, addr, i + 10, i, i % object_qty);
     }
-    (*object)->code       = code;
-    (*object)->ro_data    = ro_data;
-    (*object)->rw_data    = rw_data;
-    (*object)->zi_data    = zi_data;
-    (*object)->path       = NULL;
-    (*object)->old_object = NULL;
-    (*object)->next       = NULL;
 
-    return true;
+    fprintf(p_file, "\n==============================================================================\n\n");
+    fprintf(p_file, "%s\n\n\n      Code (inc. data)   RO Data    RW Data    ZI Data      Debug   %s\n\n", 
+            STR_IMAGE_COMPONENT_SIZE, STR_OBJECT_NAME);
+    for (i = 0; i < object_qty; i++)
+    {
+        fprintf(p_file, "%10zu %10zu %10zu %10zu %10zu %10zu   file%zu.o\n", 
+                (region_row_qty / object_qty) * 0x40, i % 64, (i * 2) % 128, i % 8, (i * 7) % 64, 1000 + i, i);
+    }
+    fprintf(p_file, "\n    ----------------------------------------------------------------------\n");
+    fprintf(p_file, "%10zu %10d %10d %10d %10d %10d   %s\n", region_row_qty * 0x40, 0, 0, 0, 0, 0, STR_OBJECT_TOTALS);
+    fprintf(p_file, "\n    ----------------------------------------------------------------------\n\n");
+    fprintf(p_file, "==============================================================================\n\n\n");
+    fprintf(p_file, "      Code (inc. data)   RO Data    RW Data    ZI Data      Debug   \n\n");
+    fprintf(p_file, "%10zu %10d %10d %10d %10d %10d   %s\n", region_row_qty * 0x40, 0, 0, 0, 0, 0, STR_GRAND_TOTALS);
+    fprintf(p_file, "%10zu %10d %10d %10d %10d %10d   %s\n", region_row_qty * 0x40, 0, 0, 0, 0, 0, STR_ELF_IMAGE_TOTALS);
+    fprintf(p_file, "%10zu %10d %10d %10d %10d %10d   %s\n", region_row_qty * 0x40, 0, 0, 0, 0, 0, STR_ROM_TOTALS);
+
+    bool result = (ferror(p_file) == 0);
+    if (fclose(p_file) != 0) {
+        result = false;
+    }
+    return result;
 }
 
-
 /**
- * @brief  释放 object 文件信息占用的内存
- * @note   
- * @param  object_head: 链表头
+ * @brief  map 文件扫描性能测试
+ * @note   对比逐字节逆序读取文件定位 memory map 与文件映射后建立段落索引的速度，
+ *         以及 fgets + strtok 与各文本扫描函数切分行及字段的速度
+ * @param  log:      log 输出对象
+ * @param  map_path: map 文件路径
  * @retval None
  */
-void object_info_free(struct object_info **object_head)
+void benchmark_map_scan(struct log_file *log, const char *map_path)
 {
-    struct object_info *object = *object_head;
-    while (object != NULL)
+    char line_text[1024] = {0};
+    LARGE_INTEGER freq, start, stop;
+    QueryPerformanceFrequency(&freq);
+
+    /* 1. fseek + fgetc 逐字节逆序读取 */
+    FILE *p_file = fopen(map_path, "r");
+    if (p_file == NULL) {
+        return;
+    }
+
+    QueryPerformanceCounter(&start);
+    fseek(p_file, 0, SEEK_END);
+    long file_size = ftell(p_file);
+    long pos_head  = file_size;
+    long pos_end   = pos_head;
+
+    while (pos_head)
     {
-        struct object_info *temp = object;
-        object = object->next;
-        free(temp->name);
-        free(temp);
+        fseek(p_file, pos_head, SEEK_SET);
+        if (fgetc(p_file) == '\n' && (pos_end - pos_head) > 1)
+        {
+            fseek(p_file, pos_head + 1, SEEK_SET);
+            fgets(line_text, sizeof(line_text), p_file);
+            pos_end = pos_head;
+
+            if (strstr(line_text, STR_MEMORY_MAP_OF_THE_IMAGE)) {
+                break;
+            }
+        }
+        pos_head--;
     }
-    *object_head = NULL;
-}
+    QueryPerformanceCounter(&stop);
+    fclose(p_file);
 
+    double seconds = (double)(stop.QuadPart - start.QuadPart) / freq.QuadPart;
+    double scanned = (double)(file_size - pos_head) / (1024 * 1024);
+    log_print(log, "[benchmark] fgetc reverse scan: %.3f MB in %.6f s (%.1f MB/s)\n", 
+              scanned, seconds, seconds > 0 ? scanned / seconds : 0.0);
 
-/**
- * @brief  初始化动态列表
- * @note   
- * @param  capacity: 列表容量
- * @retval NULL | struct prj_path_list *
- */
-struct prj_path_list * prj_path_list_init(size_t capacity)
-{
-    struct prj_path_list *list = malloc(sizeof(struct prj_path_list));
+    /* 2. 文件映射后正序建立段落索引 */
+    struct file_mapping mapping;
+    struct map_index index;
 
-    list->items    = malloc(capacity * sizeof(char *));
-    list->capacity = capacity;
-    list->size     = 0;
+    QueryPerformanceCounter(&start);
+    if (file_mapping_open(&mapping, map_path) == false) {
+        return;
+    }
+    map_index_build(&index, mapping.data, mapping.size);
+    QueryPerformanceCounter(&stop);
 
-    return list;
-}
+    seconds = (double)(stop.QuadPart - start.QuadPart) / freq.QuadPart;
+    scanned = (double)mapping.size / (1024 * 1024);
+    log_print(log, "[benchmark] mapped section index: %.3f MB in %.6f s (%.1f MB/s)\n", 
+              scanned, seconds, seconds > 0 ? scanned / seconds : 0.0);
 
+    /* 3. fgets + strtok 切分行及字段 */
+    size_t line_qty  = 0;
+    size_t field_qty = 0;
 
-/**
- * @brief  向动态列表添加元素
- * @note   
- * @param  list: 列表对象
- * @param  item: 要新增的项
- * @retval None
- */
-void prj_path_list_add(struct prj_path_list *list, char *item)
-{
-    /* 如果数组已满，将其最大容量翻倍 */
-    if (list->size == list->capacity)
+    p_file = fopen(map_path, "rb");
+    if (p_file == NULL) 
     {
-        list->capacity *= 2;
-        list->items = realloc(list->items, list->capacity * sizeof(char *));
+        file_mapping_close(&mapping);
+        return;
     }
-    list->items[list->size++] = item;
-}
-
 
-/**
- * @brief  释放动态列表
- * @note   
- * @param  list: 列表对象
- * @retval None
- */
-void prj_path_list_free(struct prj_path_list *list)
-{
-    for (size_t i = 0; i < list->size; i++) {
-        free(list->items[i]);
+    QueryPerformanceCounter(&start);
+    while (fgets(line_text, sizeof(line_text), p_file))
+    {
+        char *context = NULL;
+        line_qty++;
+        for (char *token = strtok_s(line_text, " ", &context); token; token = strtok_s(NULL, " ", &context)) {
+            field_qty++;
+        }
     }
-    free(list->items);
-    free(list);
-}
+    QueryPerformanceCounter(&stop);
+    fclose(p_file);
 
+    seconds = (double)(stop.QuadPart - start.QuadPart) / freq.QuadPart;
+    log_print(log, "[benchmark] fgets + strtok: %.3f MB in %.6f s (%.1f MB/s), %zu lines, %zu fields\n", 
+              scanned, seconds, seconds > 0 ? scanned / seconds : 0.0, line_qty, field_qty);
 
-/**
- * @brief  某路径是否为 keil 工程
- * @note   
- * @param  path: 路径
- * @retval true: 是 | false: 否
- */
-bool is_keil_project(const char *path)
-{
-    for (size_t i = 0; i < sizeof(_keil_prj_extension) / sizeof(_keil_prj_extension[0]); i++)
+    /* 4. 文件映射后使用各文本扫描函数切分行及字段 */
+    struct scan_kernel kernels[SCAN_KERNEL_QTY];
+    struct scan_kernel selected = _scan;
+    size_t kernel_qty = scan_kernel_list(kernels, SCAN_KERNEL_QTY);
+
+    for (size_t i = 0; i < kernel_qty; i++)
     {
-        char *dot = strrchr(path, '.');
-        if (dot == NULL) {
-            return false;
+        const char *end = mapping.data + mapping.size;
+        _scan     = kernels[i];
+        line_qty  = 0;
+        field_qty = 0;
+
+        QueryPerformanceCounter(&start);
+        for (const char *line = mapping.data; line < end; line_qty++)
+        {
+            line = _scan.find_byte(line, end, '\n');
+            line = (line < end) ? line + 1 : end;
         }
+        QueryPerformanceCounter(&stop);
 
-        if (strncmp(dot, _keil_prj_extension[i], strlen(_keil_prj_extension[i])) == 0) {
-            return true;
+        seconds = (double)(stop.QuadPart - start.QuadPart) / freq.QuadPart;
+        log_print(log, "[benchmark] mapped %s line scan: %.3f MB in %.6f s (%.1f MB/s), %zu lines\n", 
+                  kernels[i].name, scanned, seconds, seconds > 0 ? scanned / seconds : 0.0, line_qty);
+
+        line_qty = 0;
+        QueryPerformanceCounter(&start);
+        for (const char *line = mapping.data; line < end; line_qty++)
+        {
+            struct text_range range = {line, _scan.find_byte(line, end, '\n')};
+            struct text_range field;
+            line = (range.end < end) ? range.end + 1 : end;
+            while (text_range_field(&range, &field)) {
+                field_qty++;
+            }
         }
-    }
+        QueryPerformanceCounter(&stop);
 
-    return false;
+        seconds = (double)(stop.QuadPart - start.QuadPart) / freq.QuadPart;
+        log_print(log, "[benchmark] mapped %s line + field scan: %.3f MB in %.6f s (%.1f MB/s), %zu lines, %zu fields\n", 
+                  kernels[i].name, scanned, seconds, seconds > 0 ? scanned / seconds : 0.0, line_qty, field_qty);
+    }
+    _scan = selected;
+    file_mapping_close(&mapping);
 }
 
-
 /**
- * @brief  字符串比对
- * @note   
- * @param  str1:     字符串 1
- * @param  str2[]:   字符串组 2
- * @param  str2_qty: 字符串组 2 的数量
- * @retval true: 一致 | false: 不一致
+ * @brief  性能测试
+ * @note   分别对传入的 map 文件及生成的 BENCHMARK_MAP_SIZE 大小的 map 文件进行扫描测试，
+ *         并对比 strtok + strtoul 与 object_row_decode 解析 Image component size 表的速度
+ * @param  log:      log 输出对象
+ * @param  map_path: map 文件路径
+ * @retval None
  */
-bool is_same_string(const char *str1, 
-                    const char *str2[], 
-                    size_t str2_qty)
+void benchmark_process(struct log_file *log, const char *map_path)
 {
-    for (size_t i = 0; i < str2_qty; i++)
+    char line_text[1024] = {0};
+    char bench_path[MAX_PATH + 8] = {0};
+    LARGE_INTEGER freq, start, stop;
+    double seconds = 0;
+    double scanned = 0;
+    QueryPerformanceFrequency(&freq);
+
+    log_print(log, "[benchmark] map: %s\n", map_path);
+    benchmark_map_scan(log, map_path);
+
+    /* 生成大 map 文件，扫描完成后删除 */
+    snprintf(bench_path, sizeof(bench_path), "%s.bench", map_path);
+    if (benchmark_map_generate(bench_path, BENCHMARK_MAP_SIZE))
     {
-        if (strcmp(str1, str2[i]) == 0) {
-            return true;
+        log_print(log, "[benchmark] generated map: %s\n", bench_path);
+        benchmark_map_scan(log, bench_path);
+    }
+    else {
+        log_print(log, "[benchmark] generate map failed: %s\n", bench_path);
+    }
+    DeleteFile(bench_path);
+
+    /* 5. 解析生成的 Image component size 表 */
+    struct text_buffer table = {0};
+    struct text_buffer line  = {0};
+    const size_t row_qty = 50000;
+
+    for (size_t i = 0; i < row_qty; i++)
+    {
+        uint32_t code = (uint32_t)(i * 2654435761u) % 200000;
+        int len = snprintf(line_text, sizeof(line_text), "%11u %10u %10u %10u %10u %10u   object_file_%zu.o\n", 
+                           code, code / 16, code / 8, (uint32_t)i % 64, (uint32_t)(i * 40503u) % 8192, code * 3, i);
+        if (text_buffer_append(&table, line_text, len) == false) {
+            goto __exit;
         }
     }
+    scanned = (double)table.size / (1024 * 1024);
 
-    return false;
+    for (size_t method = 0; method < 2; method++)
+    {
+        struct text_range range = {table.data, table.data + table.size};
+        uint64_t sum   = 0;
+        size_t   count = 0;
+
+        QueryPerformanceCounter(&start);
+        while (text_range_getline(&range, &line))
+        {
+            if (method == 0)
+            {
+                uint32_t value[OBJECT_INFO_STR_QTY - 1] = {0};
+                char *context = NULL;
+                char *token   = strtok_s(line.data, " ", &context);
+                size_t index  = 0;
+
+                for (; token && index < OBJECT_INFO_STR_QTY - 1; token = strtok_s(NULL, " ", &context)) {
+                    value[index++] = strtoul(token, NULL, 10);
+                }
+                if (token) 
+                {
+                    sum += value[0] + value[2] + value[3] + value[4] + token[0];
+                    count++;
+                }
+            }
+            else
+            {
+                struct object_row row;
+                if (object_row_decode(line.data, line.size, &row)) 
+                {
+                    sum += row.value[0] + row.value[2] + row.value[3] + row.value[4] + row.name.start[0];
+                    count++;
+                }
+            }
+        }
+        QueryPerformanceCounter(&stop);
+
+        seconds = (double)(stop.QuadPart - start.QuadPart) / freq.QuadPart;
+        log_print(log, "[benchmark] %s: %zu rows (%.3f MB) in %.6f s (%.1f Mrows/s), checksum %llu\n", 
+                  (method == 0) ? "strtok + strtoul rows" : "object_row_decode rows", count, scanned, 
+                  seconds, seconds > 0 ? count / seconds / 1e6 : 0.0, (unsigned long long)sum);
+    }
+
+__exit:
+    log_print(log, " \n");
+    text_buffer_free(&table);
+    text_buffer_free(&line);
 }
+#endif
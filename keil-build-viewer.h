@@ -18,6 +18,54 @@
 #define OBJECT_INFO_STR_QTY             7       /* Code + (inc. data) + RO Data + RW Data + ZI Data + Debug + Object Name */
 
 #define ENABLE_REFER_TO_KEIL_DIALOG     0       /* 当 chip 没有对应的 keil pack 且使用自定义的 scatter file 时，是否参考 keil 的 memory dialog */
+#define ENABLE_BENCHMARK                0       /* 是否编译性能测试代码，开启后可通过 -BENCH 参数运行 */
+#define BENCHMARK_MAP_SIZE              (100u * 1024 * 1024)    /* 性能测试生成的 map 文件大小 */
+#define ENABLE_SIMD_SCAN                1       /* 是否编译 SSE2/AVX2 的文本扫描函数，运行时按 CPU 支持的指令集选择 */
+
+#if (ENABLE_SIMD_SCAN != 0) && defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define SCAN_SIMD_X86                   1
+#include <immintrin.h>
+#endif
+
+#define SCAN_KERNEL_QTY                 3       /* scalar + SSE2 + AVX2 */
+
+#define ARENA_BLOCK_SIZE                (64 * 1024) /* arena 每次向系统申请的最小内存块大小 */
+
+#define RECORD_MAGIC                    0x5256424B  /* "KBVR" */
+#define RECORD_VERSION                  1           /* 记录文件格式改变时递增，版本不同的记录文件将被忽略 */
+#define RECORD_FLAG_OBJECT              0x0001      /* 记录文件包含 object 信息 */
+#define RECORD_STORE_MAGIC              0x5356424B  /* "KBVS" */
+#define RECORD_STORE_VERSION            1
+#define RECORD_STORE_LOCK_TIMEOUT       5000        /* 等待其他进程保存同一记录存储文件的最长时间，单位 ms */
+#define RECORD_FILE_REPLACE_TIMEOUT     1000        /* 替换记录文件失败时的最长重试时间，单位 ms */
+#define RECORD_KEY_SEPARATOR            "|"         /* 记录的 key 为 "工程名|target 名" */
+
+#define HISTORY_MAGIC                   0x4856424B  /* "KBVH" */
+#define HISTORY_VERSION                 2
+#define HISTORY_FRAME_MAGIC             0x4656424B  /* "KBVF" */
+#define HISTORY_FLAG_OBJECT             0x0001      /* 构建包含 object 信息 */
+#define HISTORY_FLAG_KEYFRAME           0x0002      /* 包含全部 object，否则仅包含与上次构建的差异 */
+#define HISTORY_KEYFRAME_INTERVAL       64          /* 同一工程及 target 每隔多少次构建保存一次全部 object */
+#define HISTORY_NAME_NONE               UINT32_MAX  /* 无效的名称序号 */
+#define HISTORY_DEFAULT_BUILD_QTY       20          /* -HOBJ 默认显示的构建数量 */
+
+#define CACHE_STORE_MAGIC               0x4356424B  /* "KBVC" */
+#define CACHE_MAGIC                     0x4556424B  /* "KBVE" */
+#define CACHE_VERSION                   1           /* 缓存格式或输出内容改变时递增，版本不同的缓存将被忽略 */
+#define CACHE_INPUT_MAX                 8           /* 单个工程及 target 的最大输入文件数量 */
+#define CACHE_INPUT_MISSING             UINT64_MAX  /* 输入文件不存在 */
+
+#define INTERN_BUCKET_QTY               1024        /* intern 表的初始桶数量，字符串数量超过桶数量的 2 倍时扩容 */
+
+#define MODEL_STORE_MAGIC               0x4D56424B  /* "KBVM" */
+#define MODEL_MAGIC                     0x5056424B  /* "KBVP" */
+#define MODEL_VERSION                   1           /* 工程模型格式改变时递增，版本不同的模型将被忽略 */
+#define MODEL_STRING_NONE               UINT32_MAX  /* 字符串为 NULL */
+#define MODEL_FLAG_TARGET               0x0001      /* 已从 uvoptx 文件获取 target 名 */
+#define MODEL_FLAG_PACK                 0x0002
+#define MODEL_FLAG_LTO                  0x0004
+#define MODEL_FLAG_USER_LIB             0x0008
+#define MODEL_FLAG_CUSTOM_SCATTER       0x0010
 
 #define UNKNOWN_MEMORY_ID               1
 #define ZI_SYMBOL_0                     0x4F    /* O */
@@ -41,6 +89,9 @@
 #define STR_MAX_STACK_USAGE             "Maximum Stack Usage "
 #define STR_FILE                        "FILE(s)"
 #define STR_LTO_LLVW                    "lto-llvm-"
+#define STR_SECTION_CROSS_REFERENCES    "Section Cross References"
+#define STR_REMOVING_UNUSED_SECTIONS    "Removing Unused input sections"
+#define STR_IMAGE_SYMBOL_TABLE          "Image Symbol Table"
 #define STR_MEMORY_MAP_OF_THE_IMAGE     "Memory Map of the image"
 #define STR_LOAD_REGION                 "Load Region"
 #define STR_EXECUTION_REGION            "Execution Region"
@@ -55,34 +106,49 @@
 #define STR_LIBRARY_NAME                "Library Name"
 #define STR_OBJECT_TOTALS               "Object Totals"
 #define STR_LIBRARY_TOTALS              "Library Totals"
-#define LABEL_TARGET_NAME               "<TargetName>"
-#define LABEL_IS_CURRENT_TARGET         "<IsCurrentTarget>"
-#define LABEL_DEVICE                    "<Device>"
-#define LABEL_VENDOR                    "<Vendor>"
-#define LABEL_CPU                       "<Cpu>"
-#define LABEL_OUTPUT_DIRECTORY          "<OutputDirectory>"
-#define LABEL_OUTPUT_NAME               "<OutputName>"
-#define LABEL_LISTING_PATH              "<ListingPath>"
-#define LABEL_IS_CREATE_MAP             "<AdsLLst>"
-#define LABEL_AC6_LTO                   "<v6Lto>"
-#define LABEL_IS_KEIL_SCATTER           "<umfTarg>"
-#define LABEL_END_GROUPS                "</Groups>"
-#define LABEL_END_FILE                  "</File>"
-#define LABEL_END_FILES                 "</Files>"
-#define LABEL_END_CADS                  "</Cads>"
-#define LABEL_END_LDADS                 "</LDads>"                      
-#define LABEL_GROUP_NAME                "<GroupName>"
-#define LABEL_FILE_NAME                 "<FileName>"
-#define LABEL_FILE_TYPE                 "<FileType>"
-#define LABEL_FILE_PATH                 "<FilePath>"
-#define LABEL_INCLUDE_IN_BUILD          "<IncludeInBuild>"
-#define LABEL_ONCHIP_MEMORY             "<OnChipMemories>"
-#define LABEL_END_ONCHIP_MEMORY         "</OnChipMemories>"
-#define LABEL_MEMORY_AREA               "<OCR_RVCT"
-#define LABLE_END_MEMORY_AREA           "</OCR_RVCT"
-#define LABEL_MEMORY_TYPE               "<Type>"
-#define LABEL_MEMORY_ADDRESS            "<StartAddress>"
-#define LABEL_MEMORY_SIZE               "<Size>"
+#define STR_GRAND_TOTALS                "Grand Totals"
+#define STR_ELF_IMAGE_TOTALS            "ELF Image Totals"
+#define STR_ROM_TOTALS                  "ROM Totals"
+/* uvoptx 及 uvprojx 文件中的元素名 */
+#define LABEL_TARGET                    "Target"
+#define LABEL_TARGET_NAME               "TargetName"
+#define LABEL_IS_CURRENT_TARGET         "IsCurrentTarget"
+#define LABEL_DEVICE                    "Device"
+#define LABEL_VENDOR                    "Vendor"
+#define LABEL_CPU                       "Cpu"
+#define LABEL_OUTPUT_DIRECTORY          "OutputDirectory"
+#define LABEL_OUTPUT_NAME               "OutputName"
+#define LABEL_LISTING_PATH              "ListingPath"
+#define LABEL_IS_CREATE_MAP             "AdsLLst"
+#define LABEL_AC6_LTO                   "v6Lto"
+#define LABEL_IS_KEIL_SCATTER           "umfTarg"
+#define LABEL_GROUPS                    "Groups"
+#define LABEL_FILE                      "File"
+#define LABEL_FILES                     "Files"
+#define LABEL_CADS                      "Cads"
+#define LABEL_LDADS                     "LDads"
+#define LABEL_GROUP_NAME                "GroupName"
+#define LABEL_FILE_NAME                 "FileName"
+#define LABEL_FILE_TYPE                 "FileType"
+#define LABEL_FILE_PATH                 "FilePath"
+#define LABEL_INCLUDE_IN_BUILD          "IncludeInBuild"
+#define LABEL_ONCHIP_MEMORY             "OnChipMemories"
+#define LABEL_MEMORY_AREA               "OCR_RVCT"      /* OCR_RVCT1 ~ OCR_RVCT10，按前缀匹配 */
+#define LABEL_MEMORY_TYPE               "Type"
+#define LABEL_MEMORY_ADDRESS            "StartAddress"
+#define LABEL_MEMORY_SIZE               "Size"
+#define MEMORY_AREA_MAX                 10
+
+#define KEYWORD_BIT(keyword)            (1UL << (keyword))
+
+/* 由编译器检查 log 输出的格式字符串与参数是否匹配 */
+#if defined(__clang__)
+#define LOG_FORMAT_CHECK(fmt_pos, arg_pos)  __attribute__((format(printf, fmt_pos, arg_pos)))
+#elif defined(__GNUC__)
+#define LOG_FORMAT_CHECK(fmt_pos, arg_pos)  __attribute__((format(gnu_printf, fmt_pos, arg_pos)))
+#else
+#define LOG_FORMAT_CHECK(fmt_pos, arg_pos)
+#endif
 
 #define log_save(log, fmt, ...)         log_write(log, false, fmt, ##__VA_ARGS__)
 #define log_print(log, fmt, ...)        log_write(log, true, fmt, ##__VA_ARGS__)
@@ -122,6 +188,29 @@ typedef enum
 
 } MEMORY_TYPE;
 
+typedef enum 
+{
+    MAP_SECTION_CROSS_REFERENCES = 0x00,
+    MAP_SECTION_REMOVING_UNUSED,
+    MAP_SECTION_SYMBOL_TABLE,
+    MAP_SECTION_MEMORY_MAP,
+    MAP_SECTION_COMPONENT_SIZES,
+    MAP_SECTION_QTY,
+
+} MAP_SECTION;
+
+typedef enum 
+{
+    MAP_TOTALS_OBJECT = 0x00,
+    MAP_TOTALS_LIBRARY_MEMBER,  /* Library Member Name 之后的 Library Totals */
+    MAP_TOTALS_LIBRARY,         /* Library Name 之后的 Library Totals */
+    MAP_TOTALS_GRAND,
+    MAP_TOTALS_ELF_IMAGE,
+    MAP_TOTALS_ROM,
+    MAP_TOTALS_QTY,
+
+} MAP_TOTALS;
+
 typedef enum 
 {
     OBJECT_FILE_TYPE_UNKNOWN = 0x00,
@@ -131,6 +220,229 @@ typedef enum
 
 } OBJECT_FILE_TYPE;
 
+/* 扫描 map 文件时按行匹配的关键字 */
+typedef enum 
+{
+    KEYWORD_IMAGE_COMPONENT_SIZE = 0x00,
+    KEYWORD_LOAD_REGION,
+    KEYWORD_EXECUTION_REGION,
+    KEYWORD_LOAD_BASE,
+    KEYWORD_HEX,                /* "0x" */
+    KEYWORD_ZERO_INIT,
+    KEYWORD_PADDING,
+    KEYWORD_OBJECT_FILE,        /* ".o" */
+    KEYWORD_LIBRARY_MEMBER_NAME,
+    KEYWORD_LIBRARY_NAME,
+    KEYWORD_OBJECT_TOTALS,
+    KEYWORD_QTY,
+
+} KEYWORD;
+
+typedef enum 
+{
+    XML_EVENT_NONE = 0x00,
+    XML_EVENT_START,            /* <name ...> 或 <name/> */
+    XML_EVENT_TEXT,             /* 元素之间的非空白文本 */
+    XML_EVENT_END,              /* </name> 或 <name/> */
+
+} XML_EVENT_TYPE;
+
+
+/* 记录头。各段以距记录起始的偏移定位，均为 4 字节对齐；
+   名称以距字符串表起始的偏移表示，字符串以 '\0' 结尾 */
+struct record_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t file_size;
+    uint32_t object_qty;
+    uint32_t object_offset;
+    uint32_t load_region_qty;
+    uint32_t load_region_offset;
+    uint32_t exec_region_qty;
+    uint32_t exec_region_offset;
+    uint32_t string_size;
+    uint32_t string_offset;
+};
+
+struct record_object
+{
+    uint32_t name;
+    uint32_t code;
+    uint32_t ro_data;
+    uint32_t rw_data;
+    uint32_t zi_data;
+};
+
+struct record_load_region
+{
+    uint32_t name;
+    uint32_t exec_region_index;     /* 第一个 execution region 在 execution region 段中的序号 */
+    uint32_t exec_region_qty;
+};
+
+struct record_exec_region
+{
+    uint32_t name;
+    uint32_t base_addr;
+    uint32_t size;
+    uint32_t used_size;
+};
+
+/* 记录存储文件头。同一目录下所有工程及 target 的记录保存在一个文件中，
+   每个记录以 key 区分，记录的内容即 record_header 开始的完整记录 */
+struct record_store_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t file_size;
+    uint32_t entry_qty;
+    uint32_t entry_offset;
+    uint32_t string_size;
+    uint32_t string_offset;
+};
+
+struct record_store_entry
+{
+    uint32_t key;           /* key 在字符串表中的偏移 */
+    uint32_t offset;        /* 记录距文件起始的偏移，4 字节对齐 */
+    uint32_t size;
+};
+
+/* 构建历史文件头，其后为按构建顺序追加的 frame */
+struct history_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+};
+
+/* 单次构建的 frame，其后为 varint 编码的内容，依次为：
+   1. 新增的名称数量，各名称的长度及内容。名称在整个文件中按首次出现的顺序编号
+   2. key 的名称序号
+   3. region 数量，各 region 的名称序号、基地址、大小、已用大小
+   4. 包含 object 信息时，keyframe 为 object 数量及各 object；
+      否则为删除的 object 数量及名称序号，变化的 object 数量及各 object
+   object 按名称序号递增排列并记录与前一个序号的差值，
+   各 object 依次为名称序号、code、RO data、RW data、ZI data */
+struct history_frame_header
+{
+    uint32_t magic;
+    uint32_t size;
+    uint32_t seq;           /* 在文件中的序号，从 1 开始连续递增 */
+    uint16_t flags;
+    uint16_t reserved;
+    int64_t  time;
+};
+
+/* 分析任务生成的本次构建信息，追加时编码为 frame。行的格式与记录相同 */
+struct history_build_header
+{
+    uint16_t flags;
+    uint16_t reserved;
+    uint32_t key;           /* key 在字符串表中的偏移，与记录的 key 相同 */
+    int64_t  time;
+    uint32_t region_qty;
+    uint32_t region_offset; /* struct record_exec_region */
+    uint32_t object_qty;
+    uint32_t object_offset; /* struct record_object */
+    uint32_t string_size;
+    uint32_t string_offset;
+};
+
+/* 单个工程及 target 的分析缓存，输入文件、参数及上次的记录均未改变时重放打印的内容。
+   64 位成员可能未对齐，复制后访问 */
+struct cache_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t options;       /* 影响打印内容的参数 */
+    uint64_t record_hash;   /* 分析时使用的上次记录的哈希值，没有记录时为 0 */
+    uint32_t size;
+    uint32_t record_key;    /* 记录的 key 在字符串表中的偏移 */
+    uint32_t input_qty;
+    uint32_t input_offset;  /* struct cache_input */
+    uint32_t print_size;
+    uint32_t print_offset;  /* 打印的内容 */
+    uint32_t history_size;
+    uint32_t history_offset;/* 本次构建的信息，重放时更新构建时间 */
+    uint32_t string_size;
+    uint32_t string_offset;
+};
+
+/* 输入文件的指纹，大小及修改时间相同时视为未改变，否则比较内容的哈希值 */
+struct cache_input
+{
+    uint32_t path;          /* 路径在字符串表中的偏移 */
+    uint32_t reserved;
+    uint64_t size;          /* 文件不存在时为 CACHE_INPUT_MISSING */
+    uint64_t time;          /* 最后修改时间 */
+    uint64_t hash;
+};
+
+/* 本次分析使用的输入文件，在读取文件之前获取指纹 */
+struct cache_input_list
+{
+    const char *path[CACHE_INPUT_MAX];
+    struct cache_input input[CACHE_INPUT_MAX];
+    size_t qty;             /* 超过 CACHE_INPUT_MAX 时无法缓存 */
+};
+
+/* 单个工程及 target 解析 uvoptx 及 uvprojx 文件得到的工程模型，两者均未改变时无需重新解析。
+   字符串均为字符串表中的偏移 */
+struct model_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;         /* MODEL_FLAG_xxx */
+    uint32_t size;
+    uint32_t target_name;   /* uvoptx 文件中启用的 target 名 */
+    uint32_t chip;
+    uint32_t uvprojx_target;
+    uint32_t output_name;
+    uint32_t output_path;
+    uint32_t listing_path;
+    uint32_t input_qty;
+    uint32_t input_offset;  /* struct cache_input */
+    uint32_t memory_qty;
+    uint32_t memory_offset; /* struct model_memory */
+    uint32_t file_qty;
+    uint32_t file_offset;   /* struct model_file，重命名之前的文件列表 */
+    uint32_t string_size;
+    uint32_t string_offset;
+};
+
+struct model_memory
+{
+    uint32_t name;          /* 没有名称时为 MODEL_STRING_NONE */
+    uint32_t id;
+    uint32_t base_addr;
+    uint32_t size;
+    uint8_t type;
+    uint8_t is_from_pack;
+    uint8_t is_offchip;
+    uint8_t reserved;
+};
+
+struct model_file
+{
+    uint32_t old_name;
+    uint32_t object_name;
+    uint32_t new_object_name;
+    uint32_t path;
+    uint8_t file_type;
+    uint8_t is_rename;
+    uint16_t reserved;
+};
+
+/* 保存到记录存储文件的单个条目 */
+struct record_store_item
+{
+    const char *key;
+    const struct text_buffer *image;
+};
 
 /* keil 工程路径存储链表 */
 struct prj_path_list
@@ -142,13 +454,13 @@ struct prj_path_list
 
 struct object_info
 {
-    char *name;
-    char *path;
+    const char *name;       /* intern 字符串 */
+    const char *path;
     uint32_t code;
     uint32_t ro_data;
     uint32_t rw_data;
     uint32_t zi_data;
-    struct object_info *old_object;
+    const struct record_object *old_object;
     struct object_info *next;
 };
 
@@ -171,7 +483,8 @@ struct exec_region
     bool is_printed;
 
     struct region_block *zi_block;
-    struct exec_region *old_exec_region;
+    struct region_block *zi_block_tail;
+    const struct record_exec_region *old_exec_region;
     struct exec_region *next;
 };
 
@@ -179,6 +492,7 @@ struct load_region
 {
     char *name;
     struct exec_region *exec_region;
+    struct exec_region *exec_region_tail;
     struct load_region *next;
 };
 
@@ -194,17 +508,369 @@ struct memory_info
     struct memory_info *next;
 };
 
+/* 地址区间 [start, end) 所属的 memory */
+struct memory_interval
+{
+    uint64_t start;
+    uint64_t end;
+    const struct memory_info *memory;
+};
+
+/* 按起始地址排序且互不重叠的 memory 地址区间，按地址二分查找所属的 memory */
+struct memory_index
+{
+    struct memory_interval *interval;
+    size_t qty;
+};
+
 struct file_path_list
 {
-    char *old_name;         /* 原名 */
-    char *object_name;      /* 更改为 .o 后缀名的名称 */
-    char *new_object_name;  /* 因重名而改名后的名称，为 .o 后缀 */
-    char *path;
+    const char *old_name;           /* 原名，以下均为 intern 字符串 */
+    const char *object_name;        /* 更改为 .o 后缀名的名称 */
+    const char *new_object_name;    /* 因重名而改名后的名称，为 .o 后缀 */
+    const char *path;
     bool is_rename;
     OBJECT_FILE_TYPE file_type;
     struct file_path_list *next;
 };
 
+/* 带尾指针的链表容器，尾部追加为 O(1)，遍历顺序与添加顺序一致 */
+struct object_list
+{
+    struct object_info *head;
+    struct object_info *tail;
+    size_t size;
+};
+
+struct region_list
+{
+    struct load_region *head;
+    struct load_region *tail;
+    size_t size;
+};
+
+struct memory_list
+{
+    struct memory_info *head;
+    struct memory_info *tail;
+    size_t size;
+};
+
+struct file_list
+{
+    struct file_path_list *head;
+    struct file_path_list *tail;
+    size_t size;
+};
+
+/* 只读映射的文件 */
+struct file_mapping
+{
+    HANDLE file;
+    HANDLE mapping;
+    const char *data;
+    size_t size;
+};
+
+/* 文本区间 [start, end) */
+struct text_range
+{
+    const char *start;
+    const char *end;
+};
+
+/* Image component size 表中的一行 */
+struct object_row
+{
+    uint32_t value[OBJECT_INFO_STR_QTY - 1];    /* Code、(inc. data)、RO Data、RW Data、ZI Data、Debug */
+    struct text_range name;                     /* 指向行文本，已在行内以 '\0' 结尾，长度不受限制 */
+};
+
+/* 文本扫描函数，map、htm 及 uvprojx 的解析均通过它查找行尾及分隔符 */
+struct scan_kernel
+{
+    const char *name;
+    const char * (*find_byte)(const char *start, const char *end, char c);     /* 第一个 c 的位置，未找到时为 end */
+    const char * (*skip_byte)(const char *start, const char *end, char c);     /* 第一个不为 c 的位置，未找到时为 end */
+};
+
+/* 多关键字匹配表，按关键字的前两个字节过滤候选，一次扫描即可找到一行中的全部关键字 */
+struct keyword_matcher
+{
+    const char *keyword[KEYWORD_QTY];
+    size_t length[KEYWORD_QTY];
+    uint32_t first[256];        /* 第一个字节为该值的关键字，第 n 位对应 KEYWORD n */
+    uint32_t second[256];       /* 第二个字节为该值的关键字 */
+};
+
+/* 一行文本的匹配结果 */
+struct keyword_match
+{
+    uint32_t found;                     /* 找到的关键字，第 n 位对应 KEYWORD n */
+    const char *pos[KEYWORD_QTY];       /* 关键字第一次出现的位置，仅 found 中对应的位有效 */
+};
+
+/* 流式 XML 解析的事件，name 及 text 均指向文件内容，不复制 */
+struct xml_event
+{
+    XML_EVENT_TYPE type;
+    const char *start;          /* 事件在文件中的起始位置 */
+    struct text_range name;     /* START 及 END 的元素名 */
+    struct text_range text;     /* TEXT 为文本；END 为叶子元素的内容，含子元素时为空 */
+};
+
+/* 流式 XML 解析器，每个字节只读取一次。不展开实体，不校验元素的嵌套 */
+struct xml_reader
+{
+    struct text_range range;    /* 尚未读取的内容 */
+    const char *content;        /* 最近一个 START 之后内容的起始位置，遇到子元素时为 NULL */
+    struct text_range empty;    /* <name/> 待返回 END 的元素名 */
+};
+
+/* 单个记录，各段直接指向记录存储文件映射的内容 */
+struct record_view
+{
+    const struct record_header *header;
+    const struct record_object *object;
+    const struct record_load_region *load_region;
+    const struct record_exec_region *exec_region;
+    const char *string;
+};
+
+/* map 文件中的顶层段落，[start, end) 为标题之后的内容 */
+struct map_section
+{
+    const char *start;
+    const char *end;
+};
+
+/* map 文件段落索引，未找到的段落和 Totals 为 NULL */
+struct map_index
+{
+    struct map_section section[MAP_SECTION_QTY];
+    const char *totals[MAP_TOTALS_QTY];     /* 各 Totals 所在行的起始位置 */
+};
+
+/* 以字符串为 key 的哈希表节点 */
+struct hash_node
+{
+    const char *key;
+    uint32_t hash;
+    void *value;
+    struct hash_node *next;
+};
+
+/* 以字符串为 key 的哈希表，key 允许重复 */
+struct hash_table
+{
+    struct hash_node **buckets;
+    size_t bucket_qty;      /* 2 的幂，元素数量超过桶的数量时翻倍 */
+    size_t size;
+    bool is_nocase;         /* key 是否忽略大小写 */
+    bool is_intern;         /* key 是否均为 intern 字符串，是则哈希值取自 intern 表，只比较指针 */
+};
+
+/* 以只读方式映射的记录存储文件，按 key 索引各个记录 */
+struct record_store
+{
+    struct file_mapping mapping;
+    const struct record_store_header *header;
+    const struct record_store_entry *entry;
+    const char *string;
+    struct hash_table index;
+};
+
+/* arena 内存块，数据区紧随其后 */
+struct arena_block
+{
+    struct arena_block *next;
+    size_t size;            /* 数据区大小 */
+    size_t used;
+};
+
+/* 只增不减的内存池，所有内存随 arena_free 一次释放 */
+struct arena
+{
+    struct arena_block *block;  /* 当前块，旧块链接在其后 */
+    size_t used;                /* 已分配给使用者的字节数 */
+    size_t reserved;            /* 向系统申请的字节数 */
+};
+
+/* intern 字符串的信息，字符串的内容紧随其后。内容相同的字符串只保存一份，比较指针即可 */
+struct intern_string
+{
+    struct intern_string *next;         /* 同一个桶中的下一个 */
+    struct intern_string *fold_next;    /* 忽略大小写的桶中的下一个，仅 fold 指向自身时有效 */
+    const struct intern_string *fold;   /* 忽略大小写后相同的字符串中第一个加入的，比较 fold 即可忽略大小写 */
+    uint32_t hash;
+    uint32_t nocase_hash;
+    size_t len;
+};
+
+/* 进程内共用的 intern 表，保存 object 名称及文件路径。各线程互斥访问，字符串在释放 intern 表前有效 */
+struct intern_table
+{
+    SRWLOCK lock;
+    struct arena arena;
+    struct intern_string **buckets;
+    struct intern_string **fold_buckets;
+    size_t bucket_qty;      /* 2 的幂，首次添加时分配 */
+    size_t size;
+};
+
+/* 文本缓冲，容量按需增长并可复用 */
+struct text_buffer
+{
+    char *data;
+    size_t size;            /* 文本长度，不含 '\0' */
+    size_t capacity;
+};
+
+/* log 输出对象。is_buffered 为 true 时内容暂存于缓冲中，由 log_file_flush 统一输出 */
+struct log_file
+{
+    FILE *file;
+    bool is_buffered;
+    struct text_buffer log;     /* 写入 log 文件的全部内容 */
+    struct text_buffer print;   /* 需要打印的内容 */
+};
+
+/* object 与 keil 工程文件的匹配索引 */
+struct file_path_index
+{
+    struct hash_table object;           /* 非 lib 文件按 new_object_name，lib 文件按 old_name */
+    struct hash_table library;          /* lib 文件按 old_name */
+    struct hash_table library_object;   /* lib 文件按 new_object_name */
+};
+
+/* uvprojx 中大小不为 0 的 memory area */
+struct memory_area
+{
+    uint8_t id;             /* 在 OnChipMemories 中的序号，从 1 开始 */
+    uint32_t addr;
+    uint32_t size;
+    MEMORY_TYPE mem_type;
+};
+
+/* uvprojx 中 memory area 的解析状态，先全部读取，再按需加入 memory info */
+struct memory_area_state
+{
+    uint8_t id;
+    uint8_t state;
+    uint32_t addr;
+    uint32_t size;
+    MEMORY_TYPE mem_type;
+    struct memory_area area[MEMORY_AREA_MAX];
+    size_t area_qty;
+};
+
+/* uvprojx 中工程文件的解析状态，name 及 path 指向 uvprojx 文件的内容 */
+struct file_path_state
+{
+    uint8_t state;
+    struct text_range path;
+    struct text_range name;
+    OBJECT_FILE_TYPE type;
+};
+
+/* execution region 中 zero init 区域块的解析状态 */
+struct region_zi_state
+{
+    bool is_zi_start;
+    uint32_t last_end_addr;
+    struct region_block *zi_block;
+};
+
+/* 解析过程的上下文，链表节点及字符串均分配自 arena。
+   解析函数的全部状态均保存于此，不同的上下文可在不同线程中同时使用 */
+struct parse_context
+{
+    struct log_file *log;
+    struct arena arena;
+    struct text_buffer line;
+    struct memory_list memory_list;
+    struct file_list file_list;
+    struct hash_table object_name_index;    /* 按 object_name 索引 file_list 中第一个同名文件，用于判断重名 */
+    struct file_path_index file_path_index;
+    struct memory_area_state memory_area;
+    struct file_path_state file_path;
+    struct region_zi_state region_zi;
+};
+
+/* 已校验的 frame，payload 为 key 之后的内容 */
+struct history_frame
+{
+    const uint8_t *payload;
+    const uint8_t *end;
+    int64_t time;
+    uint16_t flags;
+    struct history_series *series;
+};
+
+/* 同一工程及 target 的全部构建，frame 按构建顺序排列 */
+struct history_series
+{
+    const char *key;
+    const struct history_frame **frame;
+    size_t qty;
+};
+
+/* 以只读方式映射的构建历史文件，按 key 索引各工程及 target 的构建 */
+struct history
+{
+    struct file_mapping mapping;
+    size_t valid_size;          /* 有效内容的大小，其后为写入中断的残留 */
+    uint32_t frame_qty;
+    struct history_frame *frame;
+    size_t frame_capacity;
+    const char **name;          /* 按名称序号索引 */
+    size_t name_qty;
+    size_t name_capacity;
+    struct hash_table name_index;   /* 名称 -> 序号 + 1，忽略大小写 */
+    struct hash_table key_index;
+    struct arena arena;
+};
+
+/* 由 keyframe 及其后的差异还原的单次构建 */
+struct history_snapshot
+{
+    struct record_object *object;       /* 按名称序号索引，name 为 HISTORY_NAME_NONE 时不存在 */
+    size_t object_capacity;
+    struct record_exec_region *region;  /* name 为名称序号 */
+    size_t region_qty;
+    size_t region_capacity;
+    bool is_has_object;
+};
+
+/* 单个 keil 工程的分析任务，每个任务使用独立的 log 缓冲 */
+struct project_job
+{
+    char prj_path[MAX_PATH];
+    char prj_name[MAX_PRJ_NAME_SIZE];
+    struct text_range target_range;         /* target 在已映射的 uvprojx 文件中的区间，为空时分析当前 target */
+    size_t target_index;                    /* target 在 uvprojx 文件中的序号，从 1 开始，分析当前 target 时为 0 */
+    bool is_batch;                          /* 是否为多工程或多 target 分析 */
+    struct log_file log;
+    const struct record_store *record_store;        /* 上次的记录，所有任务共用 */
+    char record_key[MAX_PRJ_NAME_SIZE * 2];
+    struct text_buffer record_image;                /* 本次的记录，分析完成后统一写入 */
+    struct text_buffer history_build;               /* 本次的构建信息，分析完成后统一追加到构建历史 */
+    const struct record_store *cache_store;         /* 上次的分析缓存，所有任务共用 */
+    char cache_key[MAX_PRJ_NAME_SIZE * 2];
+    struct text_buffer cache_image;                 /* 本次的分析缓存，分析完成后统一写入 */
+    const struct record_store *model_store;         /* 上次的工程模型，所有任务共用 */
+    struct text_buffer model_image;                 /* 本次的工程模型，分析完成后统一写入 */
+    int result;
+};
+
+/* 分析任务的线程池，工作线程按序领取任务 */
+struct project_pool
+{
+    struct project_job *jobs;
+    size_t job_qty;
+    volatile LONG next;
+};
+
 struct command_list
 {
     const char *cmd;
@@ -233,12 +899,45 @@ int                     combine_path                (char       *out_path,
                                                      size_t      out_path_size,
                                                      const char *absolute_path, 
                                                      const char *relative_path);
-bool                    file_path_add               (struct file_path_list **path_head,
-                                                     const char *name,
-                                                     const char *path,
+bool                    file_path_add               (struct parse_context *ctx,
+                                                     const struct text_range *name,
+                                                     const struct text_range *path,
                                                      OBJECT_FILE_TYPE file_type);
-void                    file_path_free              (struct file_path_list **path_head);
-bool                    memory_info_add             (struct memory_info **memory_head,
+bool                    file_path_index_build       (struct file_path_index *index, 
+                                                     const struct file_list *path_list);
+void                    file_path_index_free        (struct file_path_index *index);
+uint32_t                hash_string                 (const char *str, bool is_nocase);
+uint32_t                hash_text                   (const char *str, size_t len, bool is_nocase);
+uint64_t                hash_data                   (const char *data, size_t size);
+bool                    hash_table_init             (struct hash_table *table, 
+                                                     size_t capacity, 
+                                                     bool is_nocase);
+bool                    hash_table_add              (struct hash_table *table, 
+                                                     const char *key, 
+                                                     void *value);
+void *                  hash_table_find             (const struct hash_table *table, const char *key);
+void                    hash_table_free             (struct hash_table *table);
+bool                    hash_table_grow             (struct hash_table *table, size_t bucket_qty);
+bool                    hash_table_init_intern      (struct hash_table *table, 
+                                                     size_t capacity, 
+                                                     bool is_nocase);
+void                    intern_table_init           (struct intern_table *table);
+void                    intern_table_free           (struct intern_table *table);
+bool                    intern_table_grow           (struct intern_table *table, size_t bucket_qty);
+struct intern_string *  intern_lookup               (const struct intern_table *table, 
+                                                     const char *str, 
+                                                     size_t len, 
+                                                     uint32_t hash);
+const char *            intern_add                  (struct intern_table *table, const char *str, size_t len);
+const char *            intern_find                 (struct intern_table *table, const char *str, size_t len);
+const char *            intern_find_nocase          (struct intern_table *table, const char *str, size_t len);
+const struct intern_string * intern_get             (const char *str);
+void *                  arena_alloc                 (struct arena *arena, size_t size);
+char *                  arena_strdup                (struct arena *arena, const char *str);
+char *                  arena_strndup               (struct arena *arena, const char *str, size_t len);
+void                    arena_free                  (struct arena *arena);
+bool                    memory_info_add             (struct arena *arena,
+                                                     struct memory_list *memory_list,
                                                      const char *name,
                                                      size_t      id,
                                                      uint32_t    base_addr,
@@ -246,24 +945,34 @@ bool                    memory_info_add             (struct memory_info **memory
                                                      MEMORY_TYPE mem_type,
                                                      bool        is_offchip,
                                                      bool        is_from_pack);
-void                    memory_info_free            (struct memory_info **memory_head);
-bool                    object_info_add             (struct object_info **object_head,
-                                                     const char *name,
+bool                    memory_index_build          (struct arena *arena,
+                                                     struct memory_index *index,
+                                                     const struct memory_list *memory_list);
+const struct memory_info * memory_index_find        (const struct memory_index *index, uint32_t addr);
+int                     memory_boundary_compare     (const void *a, const void *b);
+bool                    object_info_add             (struct arena *arena,
+                                                     struct object_list *object_list,
+                                                     const struct text_range *name,
                                                      uint32_t    code,
                                                      uint32_t    ro_data,
                                                      uint32_t    rw_data,
                                                      uint32_t    zi_data);
-void                    object_info_free            (struct object_info **object_head);
-struct load_region *    load_region_create          (struct load_region **region_head, const char *name);
-struct exec_region *    load_region_add_exec_region (struct load_region **region_head, 
-                                                     const char *name,
+bool                    object_info_bind_old        (const struct object_list *object_list, 
+                                                     const struct record_view *old_record);
+struct load_region *    load_region_create          (struct arena *arena,
+                                                     struct region_list *region_list, 
+                                                     const struct text_range *name);
+struct exec_region *    load_region_add_exec_region (struct arena *arena,
+                                                     struct load_region *l_region, 
+                                                     const struct text_range *name,
                                                      size_t      memory_id,
                                                      uint32_t    base_addr,
                                                      uint32_t    size,
                                                      uint32_t    used_size,
                                                      MEMORY_TYPE mem_type,
                                                      bool        is_offchip);
-void                    load_region_free            (struct load_region **region_head);
+bool                    load_region_bind_old        (const struct region_list *region_list, 
+                                                     const struct record_view *old_record);
 void                    search_files_by_extension   (const char *dir,
                                                      size_t dir_len,
                                                      const char *extension[], 
@@ -279,64 +988,258 @@ int                     parameter_process           (int    param_qty,
                                                      char   *prj_path,
                                                      size_t  path_size,
                                                      int    *err_param);
-bool                    uvoptx_file_process         (const char *file_path, 
+int                     uvoptx_file_process         (struct parse_context *ctx,
+                                                     const char *file_path, 
                                                      char *target_name,
                                                      size_t max_size);
-int                     uvprojx_file_process        (const char *file_path, 
+int                     uvprojx_file_process        (struct parse_context *ctx,
+                                                     const char *file_path, 
+                                                     const char *target_name,
+                                                     struct uvprojx_info *out_info,
+                                                     bool is_get_target_name);
+int                     uvprojx_target_process      (struct parse_context *ctx,
+                                                     const struct text_range *target_range,
                                                      const char *target_name,
                                                      struct uvprojx_info *out_info,
                                                      bool is_get_target_name);
-bool                    memory_area_process         (const char *str, bool is_new);
-bool                    file_path_process           (const char *str, bool *is_has_user_lib);
-void                    build_log_file_process      (const char *file_path);
-void                    file_rename_process         (void);
-int                     map_file_process            (const char *file_path, 
-                                                     struct load_region **region_head,
-                                                     struct object_info **object_head,
+bool                    cpu_memory_process          (struct parse_context *ctx, const struct xml_event *event);
+size_t                  uvprojx_target_index_build  (const char *data, 
+                                                     size_t size, 
+                                                     struct text_range **targets);
+bool                    memory_area_process         (struct parse_context *ctx, const struct xml_event *event);
+void                    memory_area_add             (struct parse_context *ctx, bool is_new);
+bool                    file_path_process           (struct parse_context *ctx,
+                                                     const struct xml_event *event, 
+                                                     bool *is_has_user_lib);
+void                    build_log_file_process      (struct parse_context *ctx, const char *file_path);
+const char *            build_log_block_end         (const struct text_range *range);
+bool                    build_log_path_index_build  (struct parse_context *ctx, struct hash_table *index);
+char *                  path_separator_normalize    (char *path);
+void                    file_rename_process         (struct parse_context *ctx);
+int                     map_file_process            (struct parse_context *ctx,
+                                                     const char *file_path, 
+                                                     struct region_list *region_list,
+                                                     struct object_list *object_list,
+                                                     bool is_get_object,
                                                      bool is_get_user_lib,
                                                      bool is_match_memory);
-int                     region_info_process         (FILE *p_file, 
-                                                     long read_start_pos,
-                                                     struct load_region **region_head,
+void                    map_index_build             (struct map_index *index, 
+                                                     const char *data, 
+                                                     size_t size);
+int                     region_info_process         (struct parse_context *ctx,
+                                                     struct text_range *range,
+                                                     struct region_list *region_list,
                                                      bool is_match_memory);
-void                    region_zi_process           (struct exec_region **e_region,
-                                                     char *text,
-                                                     size_t size_pos);
-int                     object_info_process         (struct object_info **object_head,
-                                                     FILE *p_file,
-                                                     long *end_pos,
-                                                     bool is_get_user_lib,
-                                                     uint8_t parse_mode);
-int                     record_file_process         (const char *file_path, 
-                                                     struct load_region **region_head,
-                                                     struct object_info **object_head,
-                                                     bool *is_has_object,
-                                                     bool *is_has_region,
-                                                     bool is_match_memory);
-void                    object_print_process        (struct object_info *object_head,
+void                    region_zi_process           (struct parse_context *ctx,
+                                                     struct exec_region *e_region,
+                                                     const struct text_range *text,
+                                                     size_t size_pos,
+                                                     uint32_t found);
+bool                    object_row_decode           (char *text, size_t len, struct object_row *row);
+int                     object_info_process         (struct parse_context *ctx,
+                                                     struct object_list *object_list,
+                                                     struct text_range *range,
+                                                     bool is_get_user_lib);
+bool                    record_section_check        (size_t file_size, 
+                                                     uint32_t offset, 
+                                                     uint32_t qty, 
+                                                     size_t item_size);
+int                     record_view_open            (struct record_view *record, 
+                                                     const char *data, 
+                                                     size_t size);
+int                     record_store_open           (struct record_store *store, 
+                                                     const char *file_path, 
+                                                     uint32_t magic);
+const char *            record_store_data           (const struct record_store *store, 
+                                                     const char *key, 
+                                                     size_t *size);
+uint64_t                record_store_hash           (const struct record_store *store, const char *key);
+int                     record_store_find           (const struct record_store *store, 
+                                                     const char *key, 
+                                                     struct record_view *record);
+HANDLE                  record_store_lock           (const char *file_path);
+int                     record_store_rewrite        (struct record_store *store, 
+                                                     const char *file_path, 
+                                                     uint32_t magic, 
+                                                     const struct record_store_item *items, 
+                                                     size_t item_qty);
+int                     record_store_save           (struct record_store *store, 
+                                                     const char *file_path, 
+                                                     uint32_t magic, 
+                                                     const struct record_store_item *items, 
+                                                     size_t item_qty);
+void                    record_store_close          (struct record_store *store);
+int                     history_open                (struct history *history, const char *file_path);
+void                    history_close               (struct history *history);
+bool                    history_file_backup         (const char *file_path);
+bool                    history_index_init          (struct history *history);
+int                     history_frame_index         (struct history *history, 
+                                                     const struct history_frame_header *header, 
+                                                     const uint8_t *payload, 
+                                                     const uint8_t *end);
+uint32_t                history_name_add            (struct history *history, const char *str, size_t len);
+uint32_t                history_name_find           (const struct history *history, const char *str);
+uint32_t                history_name_intern         (struct history *history, 
+                                                     const char *str, 
+                                                     struct text_buffer *name, 
+                                                     uint32_t *new_qty);
+bool                    history_snapshot_apply      (const struct history *history, 
+                                                     const struct history_frame *frame, 
+                                                     struct history_snapshot *snapshot);
+bool                    history_snapshot_load       (const struct history *history, 
+                                                     const struct history_series *series, 
+                                                     size_t index, 
+                                                     struct history_snapshot *snapshot);
+void                    history_snapshot_free       (struct history_snapshot *snapshot);
+bool                    history_build_create        (struct text_buffer *build,
+                                                     const char *key,
+                                                     int64_t time,
+                                                     const struct object_list *object_list,
+                                                     const struct region_list *region_list);
+int                     history_row_compare         (const void *a, const void *b);
+bool                    history_row_write           (struct text_buffer *buffer, 
+                                                     const struct record_object *object, 
+                                                     uint32_t *last_name);
+bool                    history_frame_encode        (struct history *history, 
+                                                     const char *build_data, 
+                                                     uint32_t seq, 
+                                                     struct text_buffer *frame);
+int                     history_append              (struct history *history, 
+                                                     const char *file_path, 
+                                                     struct project_job *jobs, 
+                                                     size_t job_qty);
+void                    history_object_print        (struct log_file *log,
+                                                     const struct history *history,
+                                                     const struct history_series *series,
+                                                     const char *name,
+                                                     size_t build_qty);
+void                    history_region_print        (struct log_file *log,
+                                                     const struct history *history,
+                                                     const struct history_series *series,
+                                                     const char *name,
+                                                     double percent);
+uint16_t                cache_options               (void);
+void                    cache_input_add             (struct parse_context *ctx, 
+                                                     struct cache_input_list *inputs, 
+                                                     const char *file_path, 
+                                                     const struct cache_input *input);
+bool                    cache_input_get             (const char *file_path, 
+                                                     struct cache_input *input, 
+                                                     bool is_hash);
+bool                    cache_input_check           (const char *file_path, 
+                                                     const struct cache_input *input, 
+                                                     struct cache_input *current);
+bool                    cache_replay                (struct project_job *job);
+bool                    cache_image_build           (struct project_job *job, 
+                                                     const struct cache_input_list *inputs, 
+                                                     uint64_t record_hash);
+bool                    model_load                  (struct project_job *job, 
+                                                     struct parse_context *ctx, 
+                                                     struct cache_input_list *inputs, 
+                                                     char *target_name, 
+                                                     size_t target_name_size, 
+                                                     bool *is_has_target, 
+                                                     struct uvprojx_info *uvprojx_file);
+bool                    model_image_build           (struct project_job *job, 
+                                                     const struct parse_context *ctx, 
+                                                     const struct cache_input_list *inputs, 
+                                                     const char *target_name, 
+                                                     bool is_has_target, 
+                                                     const struct uvprojx_info *uvprojx_file);
+bool                    varint_write                (struct text_buffer *buffer, uint32_t value);
+bool                    varint_read                 (const uint8_t **data, const uint8_t *end, uint32_t *value);
+void                    record_key_build            (char *out_key, 
+                                                     size_t out_key_size, 
+                                                     const char *prj_name, 
+                                                     const char *target_name);
+bool                    record_string_add           (struct text_buffer *string, 
+                                                     const char *str, 
+                                                     uint32_t *offset);
+bool                    record_image_build          (struct text_buffer *image,
+                                                     const struct object_list *object_list,
+                                                     const struct record_view *old_record,
+                                                     const struct region_list *region_list);
+int                     record_file_write           (const char *file_path, const struct text_buffer *image);
+void                    object_print_process        (struct log_file *log,
+                                                     struct object_info *object_head,
                                                      size_t max_path_len, 
                                                      bool is_has_record);
-void                    memory_mode0_print          (struct exec_region *e_region,
+void                    memory_mode0_print          (struct log_file *log,
+                                                     const struct memory_list *memory_list,
+                                                     struct exec_region *e_region,
                                                      MEMORY_TYPE mem_type,
                                                      size_t max_region_name, 
                                                      bool is_has_record,
                                                      bool is_print_null);
-void                    memory_mode1_print          (struct exec_region *e_region,
+void                    memory_mode1_print          (struct log_file *log,
+                                                     struct exec_region *e_region,
                                                      MEMORY_TYPE mem_type,
                                                      bool is_offchip,
                                                      size_t max_region_name, 
                                                      bool is_has_record);
-void                    memory_mode2_print          (struct exec_region *e_region,
+void                    memory_mode2_print          (struct log_file *log,
+                                                     struct exec_region *e_region,
                                                      size_t max_region_name, 
                                                      bool is_has_record);
-void                    progress_print              (struct exec_region *region,
+void                    progress_print              (struct log_file *log,
+                                                     struct exec_region *region,
                                                      size_t max_region_name, 
                                                      bool is_has_record);
-void                    stack_print_process         (const char *file_path);
-void                    log_write                   (FILE *p_log, 
+void                    stack_print_process         (struct parse_context *ctx, const char *file_path);
+void                    log_write                   (struct log_file *p_log, 
                                                      bool is_print, 
                                                      const char *fmt, 
-                                                     ...);
+                                                     ...) LOG_FORMAT_CHECK(3, 4);
+void                    log_append                  (struct log_file *p_log, 
+                                                     bool is_print, 
+                                                     const char *str, 
+                                                     size_t len);
+void                    log_file_flush              (struct log_file *dst, struct log_file *src);
+bool                    file_mapping_open           (struct file_mapping *mapping, const char *file_path);
+void                    file_mapping_close          (struct file_mapping *mapping);
+bool                    text_range_getline          (struct text_range *range, struct text_buffer *line);
+bool                    text_range_field            (struct text_range *range, struct text_range *field);
+const char *            text_decimal_parse          (const char *start, const char *end, uint32_t *value);
+size_t                  scan_kernel_list            (struct scan_kernel *kernels, size_t max_qty);
+const char *            scan_find_byte_scalar       (const char *start, const char *end, char c);
+const char *            scan_skip_byte_scalar       (const char *start, const char *end, char c);
+#if defined(SCAN_SIMD_X86)
+const char *            scan_find_byte_sse2         (const char *start, const char *end, char c);
+const char *            scan_skip_byte_sse2         (const char *start, const char *end, char c);
+const char *            scan_find_byte_avx2         (const char *start, const char *end, char c);
+const char *            scan_skip_byte_avx2         (const char *start, const char *end, char c);
+#endif
+void                    keyword_matcher_init        (struct keyword_matcher *matcher);
+uint32_t                keyword_match_line          (const struct keyword_matcher *matcher, 
+                                                     const char *text, 
+                                                     size_t len, 
+                                                     struct keyword_match *match);
+const char *            text_range_find             (const struct text_range *range, const char *str);
+void                    xml_reader_init             (struct xml_reader *reader, const struct text_range *range);
+bool                    xml_reader_next             (struct xml_reader *reader, struct xml_event *event);
+bool                    xml_name_is                 (const struct xml_event *event, const char *name);
+bool                    xml_text_copy               (const struct xml_event *event, char *out, size_t out_size);
+bool                    xml_text_is_zero            (const struct xml_event *event);
+bool                    text_buffer_reserve         (struct text_buffer *buffer, size_t capacity);
+bool                    text_buffer_append          (struct text_buffer *buffer, 
+                                                     const char *str, 
+                                                     size_t len);
+void                    text_buffer_free            (struct text_buffer *line);
+void                    parse_context_init          (struct parse_context *ctx);
+void                    parse_context_free          (struct parse_context *ctx);
+int                     project_process             (struct project_job *job);
+DWORD WINAPI            project_worker              (LPVOID param);
+void                    project_pool_run            (struct project_job *jobs, 
+                                                     size_t job_qty, 
+                                                     size_t worker_qty);
+int                     project_target_expand       (struct project_job **jobs, 
+                                                     size_t *job_qty, 
+                                                     struct file_mapping *mappings);
+#if defined(ENABLE_BENCHMARK) && (ENABLE_BENCHMARK != 0)
+bool                    benchmark_map_generate      (const char *path, size_t size);
+void                    benchmark_map_scan          (struct log_file *log, const char *map_path);
+void                    benchmark_process           (struct log_file *log, const char *map_path);
+#endif
 
 
 #endif